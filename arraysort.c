@@ -0,0 +1,132 @@
+/*
+ * Sort a queue by gathering its elements into an array.
+ *
+ * Merging linked lists means chasing a pointer for every comparison, with
+ * the nodes spread all over the heap. Here the list is walked once to fill
+ * an array of (key, element) records, the array is sorted, and the list is
+ * relinked from it. Each record carries a copy of the element's key, so most
+ * comparisons are made within the array without touching the elements.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arraysort.h"
+#include "queue.h"
+
+/* Runs of this many records are sorted by insertion before merging */
+#define INSERTION_RUN 16
+
+/**
+ * struct sort_rec - An element to sort
+ * @key: copy of the key of @e, see element_t
+ * @e: the element, only read when the keys are equal
+ */
+struct sort_rec {
+    uint64_t key;
+    element_t *e;
+};
+
+/* Return > 0 if record a should be placed after record b. Like
+ * element_cmp(), but with the keys read from the records.
+ */
+static inline int cmp_rec(const struct sort_rec *a,
+                          const struct sort_rec *b,
+                          bool descend)
+{
+    int r;
+    if (a->key != b->key)
+        r = a->key < b->key ? -1 : 1;
+    else if (!(a->key & 0xff))
+        r = 0;
+    else
+        r = strcmp(a->e->value + 8, b->e->value + 8);
+    return descend ? -r : r;
+}
+
+static void insertion_sort(struct sort_rec *recs, size_t n, bool descend)
+{
+    for (size_t i = 1; i < n; i++) {
+        struct sort_rec rec = recs[i];
+        size_t j = i;
+        for (; j > 0 && cmp_rec(&recs[j - 1], &rec, descend) > 0; j--)
+            recs[j] = recs[j - 1];
+        recs[j] = rec;
+    }
+}
+
+/* Merge the sorted ranges src[lo, mid) and src[mid, hi) into dst[lo, hi) */
+static void merge_recs(struct sort_rec *dst,
+                       const struct sort_rec *src,
+                       size_t lo,
+                       size_t mid,
+                       size_t hi,
+                       bool descend)
+{
+    size_t i = lo, j = mid, k = lo;
+
+    /* if equal, take the left one -- important for sort stability */
+    while (i < mid && j < hi)
+        dst[k++] = cmp_rec(&src[i], &src[j], descend) <= 0 ? src[i++]
+                                                            : src[j++];
+    while (i < mid)
+        dst[k++] = src[i++];
+    while (j < hi)
+        dst[k++] = src[j++];
+}
+
+bool array_sort(struct list_head *head, bool descend)
+{
+    if (!head || list_empty(head) || list_is_singular(head))
+        return true;
+
+    size_t n = q_size(head);
+    struct sort_rec *recs = malloc(n * sizeof(struct sort_rec));
+    struct sort_rec *buf = malloc(n * sizeof(struct sort_rec));
+    if (!recs || !buf) {
+        free(recs);
+        free(buf);
+        return false;
+    }
+
+    size_t i = 0;
+    element_t *entry;
+    list_for_each_entry (entry, head, list) {
+        recs[i].key = entry->key;
+        recs[i].e = entry;
+        i++;
+    }
+
+    for (i = 0; i < n; i += INSERTION_RUN)
+        insertion_sort(recs + i, n - i < INSERTION_RUN ? n - i : INSERTION_RUN,
+                       descend);
+
+    /* Bottom-up merge, alternating between the two arrays */
+    struct sort_rec *src = recs, *dst = buf;
+    for (size_t width = INSERTION_RUN; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            merge_recs(dst, src, lo, mid, hi, descend);
+        }
+        struct sort_rec *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    /* Relink the list in sorted order */
+    struct list_head *prev = head;
+    for (i = 0; i < n; i++) {
+        struct list_head *node = &src[i].e->list;
+        prev->next = node;
+        node->prev = prev;
+        prev = node;
+    }
+    prev->next = head;
+    head->prev = prev;
+
+    free(recs);
+    free(buf);
+    return true;
+}
@@ -0,0 +1,23 @@
+#ifndef LAB0_ARRAYSORT_H
+#define LAB0_ARRAYSORT_H
+
+#include <stdbool.h>
+
+#include "list.h"
+
+/**
+ * array_sort() - Sort a queue through an array of its elements
+ * @head: header of queue
+ * @descend: whether or not to sort in descending order
+ *
+ * The elements are gathered into a contiguous array of records holding the
+ * first bytes of the string as an integer key, which is sorted with a stable
+ * merge sort. The list is then relinked in a single pass. Most comparisons
+ * are resolved by the keys without touching the elements.
+ *
+ * Return: true for success, false if the arrays could not be allocated, in
+ * which case the queue is left unchanged.
+ */
+bool array_sort(struct list_head *head, bool descend);
+
+#endif /* LAB0_ARRAYSORT_H */
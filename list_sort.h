@@ -0,0 +1,26 @@
+#ifndef LAB0_LIST_SORT_H
+#define LAB0_LIST_SORT_H
+
+#include "list.h"
+
+typedef int (*list_cmp_func_t)(void *,
+                               const struct list_head *,
+                               const struct list_head *);
+
+/*
+ * Once one side of a merge has won this many times in a row, the merge
+ * gallops: the rest of its winning stretch is found by exponential search
+ * and moved at once. Used by the merges of list_sort() and by
+ * merge_two_sorted() in queue.c. Zero disables galloping.
+ */
+extern int merge_gallop;
+
+__attribute__((nonnull(2, 3))) void list_sort(void *priv,
+                                              struct list_head *head,
+                                              list_cmp_func_t cmp);
+
+__attribute__((nonnull(2, 3))) void list_sort_adaptive(void *priv,
+                                                       struct list_head *head,
+                                                       list_cmp_func_t cmp);
+
+#endif /* LAB0_LIST_SORT_H */
@@ -0,0 +1,300 @@
+/*
+ * Lock-free multi-producer/multi-consumer queue of elements, after
+ * "Simple, Fast, and Practical Non-Blocking and Blocking Concurrent Queue
+ * Algorithms" by Maged M. Michael and Michael L. Scott.
+ *
+ * The list always starts with a dummy node. Inserting links a new node after
+ * the last one with a compare-and-swap, then swings tail to it. Removing
+ * swings head to the node after the dummy, which becomes the new dummy, and
+ * takes the element out of it. Any thread finding tail lagging behind
+ * advances it first.
+ *
+ * A node which left the list may still be read by threads which loaded head
+ * or tail before. Each thread announces the nodes it is about to read in its
+ * hazard pointers and checks they are still reachable afterwards. Removed
+ * dummies are retired into a list of the removing thread, which frees the
+ * ones no hazard pointer points to once the list is full. The element of a
+ * node is handed over to the one thread whose compare-and-swap on head
+ * succeeds, so only that thread ever reads it.
+ *
+ * Memory comes from the C library allocator, since the one of the test
+ * harness is not thread-safe.
+ */
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Use regular malloc/free */
+#define INTERNAL 1
+#include "mpmc.h"
+
+#define CACHE_LINE 64
+
+/* Hazard pointers per thread */
+#define MPMC_HAZARDS 2
+
+struct mpmc_node {
+    _Atomic(struct mpmc_node *) next;
+    element_t *e; /* NULL in the first dummy */
+};
+
+/**
+ * struct mpmc_thread - State of a registered thread
+ * @hazard: nodes the thread may be reading, read by all threads
+ * @q: the queue
+ * @retired: nodes removed by this thread and not freed yet
+ * @nretired: number of @retired
+ * @scan: room for a snapshot of all hazard pointers
+ */
+struct mpmc_thread {
+    _Alignas(CACHE_LINE) _Atomic(struct mpmc_node *) hazard[MPMC_HAZARDS];
+    struct mpmc *q;
+    struct mpmc_node **retired;
+    size_t nretired;
+    struct mpmc_node **scan;
+};
+
+/**
+ * struct mpmc - Header of a queue
+ * @head: the dummy node
+ * @tail: the last node, or one before it while an insert is under way
+ * @threads: handles of the threads
+ * @max_threads: number of @threads
+ * @registered: number of threads registered so far
+ * @max_retired: number of nodes a thread retires before trying to free them
+ */
+struct mpmc {
+    _Alignas(CACHE_LINE) _Atomic(struct mpmc_node *) head;
+    _Alignas(CACHE_LINE) _Atomic(struct mpmc_node *) tail;
+    _Alignas(CACHE_LINE) struct mpmc_thread *threads;
+    int max_threads;
+    atomic_int registered;
+    size_t max_retired;
+};
+
+struct mpmc *mpmc_new(int max_threads)
+{
+    if (max_threads < 1)
+        return NULL;
+
+    struct mpmc *q = aligned_alloc(CACHE_LINE, sizeof(*q));
+    if (!q)
+        return NULL;
+    struct mpmc_node *dummy = malloc(sizeof(*dummy));
+    q->threads =
+        aligned_alloc(CACHE_LINE, max_threads * sizeof(struct mpmc_thread));
+    if (!dummy || !q->threads) {
+        free(dummy);
+        free(q->threads);
+        free(q);
+        return NULL;
+    }
+
+    /* Freeing retired nodes once there are twice as many as hazard
+     * pointers frees at least half of them each time
+     */
+    size_t hazards = (size_t) max_threads * MPMC_HAZARDS;
+    q->max_retired = 2 * hazards;
+    q->max_threads = max_threads;
+    atomic_init(&q->registered, 0);
+    for (int i = 0; i < max_threads; i++) {
+        struct mpmc_thread *t = &q->threads[i];
+        for (int h = 0; h < MPMC_HAZARDS; h++)
+            atomic_init(&t->hazard[h], NULL);
+        t->q = q;
+        t->nretired = 0;
+        t->retired = malloc(q->max_retired * sizeof(*t->retired));
+        t->scan = malloc(hazards * sizeof(*t->scan));
+        if (!t->retired || !t->scan) {
+            q->max_threads = i + 1;
+            atomic_init(&dummy->next, NULL);
+            atomic_init(&q->head, dummy);
+            mpmc_free(q);
+            return NULL;
+        }
+    }
+
+    atomic_init(&dummy->next, NULL);
+    dummy->e = NULL;
+    atomic_init(&q->head, dummy);
+    atomic_init(&q->tail, dummy);
+    return q;
+}
+
+void mpmc_free(struct mpmc *q)
+{
+    if (!q)
+        return;
+
+    struct mpmc_node *node = atomic_load(&q->head);
+    bool dummy = true;
+    while (node) {
+        struct mpmc_node *next = atomic_load(&node->next);
+        if (!dummy)
+            free(node->e);
+        free(node);
+        node = next;
+        dummy = false;
+    }
+    for (int i = 0; i < q->max_threads; i++) {
+        struct mpmc_thread *t = &q->threads[i];
+        for (size_t k = 0; k < t->nretired; k++)
+            free(t->retired[k]);
+        free(t->retired);
+        free(t->scan);
+    }
+    free(q->threads);
+    free(q);
+}
+
+struct mpmc_thread *mpmc_register(struct mpmc *q)
+{
+    int i = atomic_fetch_add(&q->registered, 1);
+    if (i >= q->max_threads)
+        return NULL;
+    return &q->threads[i];
+}
+
+/* Load *src into hazard pointer h of thread t, until it is still the value
+ * of *src after being announced
+ */
+static struct mpmc_node *protect(struct mpmc_thread *t,
+                                 int h,
+                                 _Atomic(struct mpmc_node *) *src)
+{
+    struct mpmc_node *node = atomic_load(src), *again;
+
+    for (;; node = again) {
+        atomic_store(&t->hazard[h], node);
+        again = atomic_load(src);
+        if (again == node)
+            return node;
+    }
+}
+
+static void clear_hazards(struct mpmc_thread *t)
+{
+    for (int h = 0; h < MPMC_HAZARDS; h++)
+        atomic_store_explicit(&t->hazard[h], NULL, memory_order_release);
+}
+
+static bool is_hazard(struct mpmc_node **scan, size_t n, struct mpmc_node *p)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (scan[i] == p)
+            return true;
+    }
+    return false;
+}
+
+/* Free node once no hazard pointer points to it */
+static void retire(struct mpmc_thread *t, struct mpmc_node *node)
+{
+    struct mpmc *q = t->q;
+
+    t->retired[t->nretired++] = node;
+    if (t->nretired < q->max_retired)
+        return;
+
+    /* Threads registering later have no hazard pointer set */
+    int threads = atomic_load(&q->registered);
+    if (threads > q->max_threads)
+        threads = q->max_threads;
+    size_t n = 0;
+    for (int i = 0; i < threads; i++) {
+        for (int h = 0; h < MPMC_HAZARDS; h++) {
+            struct mpmc_node *p = atomic_load(&q->threads[i].hazard[h]);
+            if (p)
+                t->scan[n++] = p;
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t k = 0; k < t->nretired; k++) {
+        if (is_hazard(t->scan, n, t->retired[k]))
+            t->retired[kept++] = t->retired[k];
+        else
+            free(t->retired[k]);
+    }
+    t->nretired = kept;
+}
+
+bool mpmc_insert_tail(struct mpmc_thread *t, const char *s)
+{
+    size_t len = strlen(s) + 1;
+    struct mpmc_node *node = malloc(sizeof(*node));
+    element_t *e = malloc(sizeof(element_t) + len);
+    if (!node || !e) {
+        free(node);
+        free(e);
+        return false;
+    }
+    e->key = element_key(s);
+    e->value = memcpy(e->inline_value, s, len);
+    INIT_LIST_HEAD(&e->list);
+    e->slab = NULL;
+    node->e = e;
+    atomic_init(&node->next, NULL);
+
+    struct mpmc *q = t->q;
+    for (;;) {
+        struct mpmc_node *tail = protect(t, 0, &q->tail);
+        struct mpmc_node *next = atomic_load(&tail->next);
+        if (next) {
+            /* Help the insert under way */
+            atomic_compare_exchange_weak(&q->tail, &tail, next);
+            continue;
+        }
+        if (atomic_compare_exchange_weak(&tail->next, &next, node)) {
+            atomic_compare_exchange_strong(&q->tail, &tail, node);
+            break;
+        }
+    }
+    clear_hazards(t);
+    return true;
+}
+
+element_t *mpmc_remove_head(struct mpmc_thread *t, char *sp, size_t bufsize)
+{
+    struct mpmc *q = t->q;
+    struct mpmc_node *head;
+    element_t *e;
+
+    for (;;) {
+        head = protect(t, 0, &q->head);
+        struct mpmc_node *next = atomic_load(&head->next);
+        atomic_store(&t->hazard[1], next);
+        /* next cannot have been freed if head is still the dummy */
+        if (atomic_load(&q->head) != head)
+            continue;
+        if (!next) {
+            clear_hazards(t);
+            return NULL;
+        }
+
+        struct mpmc_node *tail = atomic_load(&q->tail);
+        if (head == tail) {
+            atomic_compare_exchange_weak(&q->tail, &tail, next);
+            continue;
+        }
+        e = next->e;
+        if (atomic_compare_exchange_weak(&q->head, &head, next))
+            break;
+    }
+    clear_hazards(t);
+    retire(t, head);
+
+    if (sp && bufsize) {
+        size_t len = strnlen(e->value, bufsize - 1);
+        memcpy(sp, e->value, len);
+        sp[len] = '\0';
+    }
+    return e;
+}
+
+void mpmc_release_element(element_t *e)
+{
+    free(e);
+}
@@ -0,0 +1,80 @@
+#ifndef LAB0_MPMC_H
+#define LAB0_MPMC_H
+
+/* An unbounded queue of elements shared by any number of producer and
+ * consumer threads, after Michael and Scott's lock-free queue. Nodes taken
+ * off the queue are reclaimed with hazard pointers, so none is freed while
+ * another thread may still read it.
+ *
+ * Each thread using the queue first registers with mpmc_register() and
+ * passes the handle it gets to the other operations.
+ *
+ * See the 'mpmc' command of qtest for a stress test.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "queue.h"
+
+struct mpmc;
+struct mpmc_thread;
+
+/**
+ * mpmc_new() - Create an empty queue
+ * @max_threads: number of threads which may register
+ *
+ * Return: NULL for allocation failed
+ */
+struct mpmc *mpmc_new(int max_threads);
+
+/**
+ * mpmc_free() - Free all storage used by queue, no effect if q is NULL
+ * @q: the queue, which no thread uses any more
+ *
+ * The elements left in the queue are freed too.
+ */
+void mpmc_free(struct mpmc *q);
+
+/**
+ * mpmc_register() - Get the handle of the calling thread
+ * @q: the queue
+ *
+ * Return: NULL if max_threads threads have registered already
+ */
+struct mpmc_thread *mpmc_register(struct mpmc *q);
+
+/**
+ * mpmc_insert_tail() - Insert an element with a copy of s at the tail
+ * @t: handle of the calling thread
+ * @s: string to insert
+ *
+ * Return: true for success, false for allocation failed
+ */
+bool mpmc_insert_tail(struct mpmc_thread *t, const char *s);
+
+/**
+ * mpmc_remove_head() - Remove the element at the head of the queue
+ * @t: handle of the calling thread
+ * @sp: buffer the string is copied to, or NULL
+ * @bufsize: size of @sp
+ *
+ * The element belongs to the caller alone once returned, no other thread
+ * reads it any more. At most bufsize - 1 characters are copied, plus a null
+ * terminator.
+ *
+ * Return: the element, to be released by mpmc_release_element(), or NULL
+ * if the queue is empty
+ */
+element_t *mpmc_remove_head(struct mpmc_thread *t, char *sp, size_t bufsize);
+
+/**
+ * mpmc_release_element() - Release an element returned by mpmc_remove_head()
+ * @e: the element
+ *
+ * Elements of this queue do not come from the slabs of a queue of queue.h,
+ * so q_release_element() must not be called on them.
+ */
+void mpmc_release_element(element_t *e);
+
+#endif /* LAB0_MPMC_H */
@@ -3,8 +3,11 @@
 #include <assert.h>
 #include <errno.h>
 #include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <spawn.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -19,8 +22,10 @@
 #include <time.h>
 #endif
 
+#include "dudect/cpucycles.h"
 #include "dudect/fixture.h"
 #include "list.h"
+#include "list_sort.h"
 #include "random.h"
 
 /* Shannon entropy */
@@ -50,7 +55,13 @@ extern int show_entropy;
 #include "game.h"
 #include "report.h"
 
+#include "arraysort.h"
+#include "mpmc.h"
+#include "radixsort.h"
+#include "spsc.h"
 #include "treesort.h"
+#include "unrolled.h"
+#include "workpool.h"
 /* Settable parameters */
 
 #define HISTORY_LEN 20
@@ -62,13 +73,6 @@ extern int show_entropy;
 #define BIG_LIST_SIZE 30
 
 /* Global variables */
-typedef int (*list_cmp_func_t)(void *,
-                               const struct list_head *,
-                               const struct list_head *);
-__attribute__((nonnull(2, 3))) void list_sort(void *,
-                                              struct list_head *,
-                                              list_cmp_func_t);
-
 void q_shuffle(struct list_head *head);
 
 typedef struct {
@@ -79,6 +83,27 @@ typedef struct {
 static queue_chain_t chain = {.size = 0};
 static queue_contex_t *current = NULL;
 
+/* Run the queue commands on unrolled lists instead of list queues, see -b */
+static bool use_unrolled = false;
+
+/* A queue of the chain. With the unrolled backend, the queue commands work
+ * on @uq and @ctx.q stays NULL.
+ */
+struct chain_queue {
+    queue_contex_t ctx;
+    struct uqueue *uq;
+};
+
+#define ctx_uq(c) (container_of(c, struct chain_queue, ctx)->uq)
+
+/* Whether there is no current queue to run a command on */
+static bool no_queue(void)
+{
+    if (!current)
+        return true;
+    return use_unrolled ? !ctx_uq(current) : !current->q;
+}
+
 /* How many times can queue operations fail */
 static int fail_limit = BIG_LIST_SIZE;
 static int fail_count = 0;
@@ -113,7 +138,7 @@ static bool do_free(int argc, char *argv[])
     }
 
     bool ok = true;
-    if (!chain.size || !current || !current->q) {
+    if (!chain.size || no_queue()) {
         report(3,
                "Warning: There is no available queue or calling free on null "
                "queue");
@@ -132,14 +157,18 @@ static bool do_free(int argc, char *argv[])
     if (current) {
         list_del(&current->chain);
 
-        if (exception_setup(true))
-            q_free(current->q);
+        if (exception_setup(true)) {
+            if (use_unrolled)
+                uq_free(ctx_uq(current));
+            else
+                q_free(current->q);
+        }
         exception_cancel();
         set_cautious_mode(true);
     }
 
     if (current) {
-        free(current);
+        free(container_of(current, struct chain_queue, ctx));
         chain.size--;
         current = qnext ? list_entry(qnext, queue_contex_t, chain) : NULL;
     }
@@ -167,11 +196,13 @@ static bool do_new(int argc, char *argv[])
     bool ok = true;
 
     if (exception_setup(true)) {
-        queue_contex_t *qctx = malloc(sizeof(queue_contex_t));
+        struct chain_queue *cq = malloc(sizeof(struct chain_queue));
+        queue_contex_t *qctx = &cq->ctx;
         list_add_tail(&qctx->chain, &chain.head);
 
         qctx->size = 0;
-        qctx->q = q_new();
+        qctx->q = use_unrolled ? NULL : q_new();
+        cq->uq = use_unrolled ? uq_new() : NULL;
         qctx->id = chain.size++;
 
         current = qctx;
@@ -197,6 +228,389 @@ static void fill_rand_string(char *buf, size_t buf_size)
     buf[len] = '\0';
 }
 
+#define INSERT_BATCH 256
+
+/* Fill n buffers as fill_rand_string() does, but with a single call to
+ * randombytes(), which costs a system call
+ */
+static void fill_rand_strings(char (*bufs)[MAX_RANDSTR_LEN], int n)
+{
+    uint8_t bytes[INSERT_BATCH][MAX_RANDSTR_LEN];
+
+    randombytes(&bytes[0][0], n * sizeof(bytes[0]));
+    for (int i = 0; i < n; i++) {
+        size_t len = 0;
+        while (len < MIN_RANDSTR_LEN)
+            len = rand() % MAX_RANDSTR_LEN;
+        for (size_t k = 0; k < len; k++)
+            bufs[i][k] = charset[bytes[i][k] % (sizeof(charset) - 1)];
+        bufs[i][len] = '\0';
+    }
+}
+
+/* Commands on the unrolled backend. They run the uq_* counterparts of the
+ * queue.h operations and check the outcome through uq_walk(), since the
+ * strings of an unrolled queue are not reachable otherwise.
+ */
+
+/* Report that a command needs list queues. Return false if the unrolled
+ * backend is used.
+ */
+static bool list_backend(const char *cmd)
+{
+    if (!use_unrolled)
+        return true;
+    report(1, "%s is not supported by the unrolled backend", cmd);
+    return false;
+}
+
+static bool unrolled_insert(position_t pos, char *inserts, int reps)
+{
+    char randstr_buf[MAX_RANDSTR_LEN];
+    struct uqueue *uq = ctx_uq(current);
+    bool ok = true;
+
+    for (int r = 0; ok && r < reps; r++) {
+        char *s = inserts;
+        if (!s) {
+            fill_rand_string(randstr_buf, sizeof(randstr_buf));
+            s = randstr_buf;
+        }
+        if (pos == POS_TAIL ? uq_insert_tail(uq, s) : uq_insert_head(uq, s)) {
+            current->size++;
+        } else {
+            fail_count++;
+            if (fail_count < fail_limit) {
+                report(2, "Insertion of %s failed", s);
+            } else {
+                report(1, "ERROR: Insertion of %s failed (%d failures total)",
+                       s, fail_count);
+                ok = false;
+            }
+        }
+        ok = ok && !error_check();
+    }
+    return ok;
+}
+
+struct walk_order {
+    const char *prev;
+    int sign; /* 1 for ascending order, -1 for descending */
+};
+
+static bool walk_order_next(const char *s, void *priv)
+{
+    struct walk_order *w = priv;
+    if (w->prev && w->sign * strcmp(w->prev, s) > 0)
+        return false;
+    w->prev = s;
+    return true;
+}
+
+/* Check that the current unrolled queue is in ascending/descending order */
+static bool unrolled_ordered(bool desc)
+{
+    struct walk_order w = {NULL, desc ? -1 : 1};
+    return uq_walk(ctx_uq(current), walk_order_next, &w);
+}
+
+static bool unrolled_sort(void)
+{
+    bool ok = true;
+
+    if (!ctx_uq(current)) {
+        q_show(3);
+        return !error_check();
+    }
+
+    /* The pointers are sorted in arrays, which must all be freed again */
+    size_t blocks = allocation_check();
+    if (exception_setup(true))
+        ok = uq_sort(ctx_uq(current), descend);
+    exception_cancel();
+
+    if (!ok) {
+        report(1, "ERROR: Could not allocate space for sorting");
+    } else if (allocation_check() != blocks) {
+        report(1, "ERROR: Sort did not free all the memory it allocated");
+        ok = false;
+    } else if (!unrolled_ordered(descend)) {
+        report(1, descend ? "ERROR: Not sorted in descending order"
+                          : "ERROR: Not sorted in ascending order");
+        ok = false;
+    }
+
+    q_show(3);
+    return ok && !error_check();
+}
+
+struct walk_strings {
+    char **s;
+    int n;
+    int i;
+};
+
+static bool walk_copy(const char *s, void *priv)
+{
+    struct walk_strings *w = priv;
+    w->s[w->i] = strdup(s);
+    return w->s[w->i++];
+}
+
+static bool walk_expect(const char *s, void *priv)
+{
+    struct walk_strings *w = priv;
+    return w->i < w->n && !strcmp(w->s[w->i++], s);
+}
+
+static void free_strings(char **s, int n)
+{
+    for (int i = 0; i < n; i++)
+        free(s[i]);
+    free(s);
+}
+
+static bool unrolled_dedup(void)
+{
+    struct uqueue *uq = ctx_uq(current);
+    int n = uq_size(uq);
+
+    /* Copy the strings, in the order of the queue */
+    struct walk_strings w = {malloc((n ? n : 1) * sizeof(char *)), n, 0};
+    if (!w.s || !uq_walk(uq, walk_copy, &w)) {
+        if (w.s)
+            free_strings(w.s, w.i);
+        report(1,
+               "INTERNAL ERROR.  Could not allocate space for duplicate "
+               "checking");
+        return false;
+    }
+
+    bool ok = true;
+    if (exception_setup(true))
+        ok = uq_delete_dup(uq);
+    exception_cancel();
+
+    if (!ok) {
+        free_strings(w.s, n);
+        report(1, "ERROR: Calling delete duplicate on null queue");
+        return false;
+    }
+
+    /* Keep the strings of the copy which have no equal neighbour */
+    char **kept = malloc((n ? n : 1) * sizeof(char *));
+    if (!kept) {
+        free_strings(w.s, n);
+        report(1,
+               "INTERNAL ERROR.  Could not allocate space for duplicate "
+               "checking");
+        return false;
+    }
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        if ((i && !strcmp(w.s[i - 1], w.s[i])) ||
+            (i + 1 < n && !strcmp(w.s[i], w.s[i + 1])))
+            current->size--;
+        else
+            kept[k++] = w.s[i];
+    }
+
+    struct walk_strings expect = {kept, k, 0};
+    ok = uq_walk(uq, walk_expect, &expect) && expect.i == k;
+    if (!ok)
+        report(1,
+               "ERROR: Duplicate strings are in queue or distinct strings are "
+               "not in queue");
+
+    free(kept);
+    free_strings(w.s, n);
+    q_show(3);
+    return ok && !error_check();
+}
+
+/* Merge all the unrolled queues of the chain into the first one */
+static bool unrolled_merge(void)
+{
+    queue_contex_t *first =
+        list_first_entry(&chain.head, queue_contex_t, chain);
+    queue_contex_t *ctx, *safe;
+    bool ok = true;
+
+    if (exception_setup(true)) {
+        list_for_each_entry_safe (ctx, safe, &chain.head, chain) {
+            if (ctx == first)
+                continue;
+            int len = uq_merge(ctx_uq(first), ctx_uq(ctx), descend);
+            if (len < 0) {
+                ok = false;
+                break;
+            }
+            first->size = len;
+            list_del(&ctx->chain);
+            uq_free(ctx_uq(ctx));
+            free(container_of(ctx, struct chain_queue, ctx));
+            chain.size--;
+        }
+    }
+    exception_cancel();
+    current = first;
+
+    if (!ok) {
+        report(1, "ERROR: Could not allocate space for merging");
+    } else if (!unrolled_ordered(descend)) {
+        report(1,
+               "ERROR: Not sorted in %s order (It might because of unsorted "
+               "queues are merged or there're some flaws in 'uq_merge')",
+               descend ? "descending" : "ascending");
+        ok = false;
+    }
+
+    q_show(3);
+    return ok && !error_check();
+}
+
+/* Keep the strictly ascending/descending strings of the current unrolled
+ * queue, as the ascend and descend commands do
+ */
+static bool unrolled_monotonic(bool desc)
+{
+    struct uqueue *uq = ctx_uq(current);
+
+    if (exception_setup(true))
+        current->size = desc ? uq_descend(uq) : uq_ascend(uq);
+    exception_cancel();
+
+    bool ok = unrolled_ordered(desc);
+    if (!ok)
+        report(1, "ERROR: At least one node violated the ordering rule");
+
+    q_show(3);
+    return ok && !error_check();
+}
+
+struct walk_show {
+    int vlevel;
+    int cnt;
+};
+
+static bool walk_show_next(const char *s, void *priv)
+{
+    struct walk_show *w = priv;
+    if (w->cnt < BIG_LIST_SIZE) {
+        report_noreturn(w->vlevel, w->cnt == 0 ? "%s" : " %s", s);
+        if (show_entropy)
+            report_noreturn(w->vlevel, "(%3.2f%%)",
+                            shannon_entropy((const uint8_t *) s));
+    }
+    w->cnt++;
+    return true;
+}
+
+static bool unrolled_show(int vlevel)
+{
+    struct uqueue *uq = current ? ctx_uq(current) : NULL;
+    if (!uq) {
+        report(vlevel, "l = NULL");
+        return true;
+    }
+
+    struct walk_show w = {vlevel, 0};
+    report_noreturn(vlevel, "l = [");
+    uq_walk(uq, walk_show_next, &w);
+    report(vlevel, "%s", w.cnt <= BIG_LIST_SIZE ? "]" : " ... ]");
+
+    if (w.cnt != current->size || uq_size(uq) != current->size) {
+        report(vlevel, "ERROR:  Queue has %d elements, expected %d", w.cnt,
+               current->size);
+        return false;
+    }
+    return true;
+}
+
+/* Return the element at the head (tail false) or the tail of the current
+ * queue, which is not empty
+ */
+static element_t *queue_end(bool tail)
+{
+    if (q_is_ring(current->q))
+        return q_at(current->q, tail ? current->size - 1 : 0);
+    if (tail != q_is_reversed(current->q))
+        return list_last_entry(current->q, element_t, list);
+    return list_first_entry(current->q, element_t, list);
+}
+
+/* Insert reps copies of inserts, or random strings if inserts is NULL, with
+ * q_insert_head_batch() or q_insert_tail_batch(). Strings which could not be
+ * inserted are skipped and count as failures, just as with single inserts.
+ */
+static bool queue_insert_batch(position_t pos, char *inserts, int reps)
+{
+    char randstrs[INSERT_BATCH][MAX_RANDSTR_LEN];
+    char *strs[INSERT_BATCH];
+    bool ok = true;
+
+    while (ok && reps > 0) {
+        int n = reps < INSERT_BATCH ? reps : INSERT_BATCH;
+        if (!inserts)
+            fill_rand_strings(randstrs, n);
+        for (int i = 0; i < n; i++)
+            strs[i] = inserts ? inserts : randstrs[i];
+        reps -= n;
+
+        for (int i = 0; ok && i < n; i++) {
+            int k = pos == POS_TAIL
+                        ? q_insert_tail_batch(current->q, strs + i, n - i)
+                        : q_insert_head_batch(current->q, strs + i, n - i);
+            current->size += k;
+
+            /* The new elements are the k nearest to the end, newest first */
+            bool ring = q_is_ring(current->q);
+            bool last = (pos == POS_TAIL) != q_is_reversed(current->q);
+            struct list_head *node = last ? current->q->prev : current->q->next;
+            char *newer = NULL;
+            for (int j = i + k - 1; ok && j >= i; j--) {
+                int at = i + k - 1 - j;
+                if (pos == POS_TAIL)
+                    at = current->size - 1 - at;
+                element_t *entry = ring ? q_at(current->q, at)
+                                        : list_entry(node, element_t, list);
+                char *cur_inserts = entry->value;
+                if (!cur_inserts) {
+                    report(1, "ERROR: Failed to save copy of string in queue");
+                    ok = false;
+                } else if (cur_inserts == strs[j]) {
+                    report(1,
+                           "ERROR: Need to allocate and copy string for new "
+                           "queue element");
+                    ok = false;
+                } else if (cur_inserts == newer) {
+                    report(1,
+                           "ERROR: Need to allocate separate string for each "
+                           "queue element");
+                    ok = false;
+                }
+                newer = cur_inserts;
+                node = last ? node->prev : node->next;
+            }
+
+            i += k;
+            if (ok && i < n) {
+                fail_count++;
+                if (fail_count < fail_limit)
+                    report(2, "Insertion of %s failed", strs[i]);
+                else {
+                    report(1,
+                           "ERROR: Insertion of %s failed (%d failures total)",
+                           strs[i], fail_count);
+                    ok = false;
+                }
+            }
+        }
+        ok = ok && !error_check();
+    }
+    return ok;
+}
+
 /* insertion */
 static bool queue_insert(position_t pos, int argc, char *argv[])
 {
@@ -238,11 +652,27 @@ static bool queue_insert(position_t pos, int argc, char *argv[])
         inserts = randstr_buf;
     }
 
-    if (!current || !current->q)
+    if (no_queue())
         report(3, "Warning: Calling insert %s on null queue",
                pos == POS_TAIL ? "tail" : "head");
     error_check();
 
+    if (current && use_unrolled) {
+        if (exception_setup(true))
+            ok = unrolled_insert(pos, need_rand ? NULL : inserts, reps);
+        exception_cancel();
+        q_show(3);
+        return ok;
+    }
+
+    if (current && reps > 1) {
+        if (exception_setup(true))
+            ok = queue_insert_batch(pos, need_rand ? NULL : inserts, reps);
+        exception_cancel();
+        q_show(3);
+        return ok;
+    }
+
     if (current && exception_setup(true)) {
         for (int r = 0; ok && r < reps; r++) {
             if (need_rand)
@@ -251,10 +681,7 @@ static bool queue_insert(position_t pos, int argc, char *argv[])
                                         : q_insert_head(current->q, inserts);
             if (rval) {
                 current->size++;
-                element_t *entry =
-                    pos == POS_TAIL
-                        ? list_last_entry(current->q, element_t, list)
-                        : list_first_entry(current->q, element_t, list);
+                element_t *entry = queue_end(pos == POS_TAIL);
                 char *cur_inserts = entry->value;
                 if (!cur_inserts) {
                     report(1, "ERROR: Failed to save copy of string in queue");
@@ -305,6 +732,45 @@ static bool do_it(int argc, char *argv[])
     return queue_insert(POS_TAIL, argc, argv);
 }
 
+/* Remove with q_take_head() or q_take_tail(), which copy nothing */
+static bool queue_take(position_t pos, int argc, char *argv[])
+{
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    bool ok = true;
+    if (!current || !current->size)
+        report(3, "Warning: Calling remove %s on empty queue",
+               pos == POS_TAIL ? "tail" : "head");
+    error_check();
+
+    element_t *re = NULL;
+    if (current && exception_setup(true))
+        re = pos == POS_TAIL ? q_take_tail(current->q)
+                             : q_take_head(current->q);
+    exception_cancel();
+
+    if (re) {
+        report(2, "Removed %.*s from queue", string_length, re->value);
+        q_release_element(re);
+        current->size--;
+    } else {
+        fail_count++;
+        if (fail_count < fail_limit) {
+            report(2, "Removal from queue failed");
+        } else {
+            report(1, "ERROR: Removal from queue failed (%d failures total)",
+                   fail_count);
+            ok = false;
+        }
+    }
+
+    q_show(3);
+    return ok && !error_check();
+}
+
 static bool queue_remove(position_t pos, int argc, char *argv[])
 {
     /* FIXME: It is known that both functions is_remove_tail_const() and
@@ -366,18 +832,29 @@ static bool queue_remove(position_t pos, int argc, char *argv[])
     error_check();
 
     element_t *re = NULL;
-    if (current && exception_setup(true))
-        re = pos == POS_TAIL
-                 ? q_remove_tail(current->q, removes, string_length + 1)
-                 : q_remove_head(current->q, removes, string_length + 1);
+    bool removed = false;
+    if (current && exception_setup(true)) {
+        if (use_unrolled) {
+            struct uqueue *uq = ctx_uq(current);
+            removed = pos == POS_TAIL
+                          ? uq_remove_tail(uq, removes, string_length + 1)
+                          : uq_remove_head(uq, removes, string_length + 1);
+        } else {
+            re = pos == POS_TAIL
+                     ? q_remove_tail(current->q, removes, string_length + 1)
+                     : q_remove_head(current->q, removes, string_length + 1);
+            removed = re;
+        }
+    }
     exception_cancel();
 
-    bool is_null = re ? false : true;
+    bool is_null = !removed;
 
     if (!is_null) {
         // q_remove_head and q_remove_tail are not responsible for releasing
         // node
-        q_release_element(re);
+        if (re)
+            q_release_element(re);
 
         removes[string_length + STRINGPAD] = '\0';
         if (removes[0] == '\0') {
@@ -434,6 +911,19 @@ static inline bool do_rt(int argc, char *argv[])
     return queue_remove(POS_TAIL, argc, argv);
 }
 
+/* Unrolled queues have no elements to take, so th and tt remove there */
+static inline bool do_th(int argc, char *argv[])
+{
+    return use_unrolled ? queue_remove(POS_HEAD, argc, argv)
+                        : queue_take(POS_HEAD, argc, argv);
+}
+
+static inline bool do_tt(int argc, char *argv[])
+{
+    return use_unrolled ? queue_remove(POS_TAIL, argc, argv)
+                        : queue_take(POS_TAIL, argc, argv);
+}
+
 static bool do_dedup(int argc, char *argv[])
 {
     if (argc != 1) {
@@ -441,15 +931,19 @@ static bool do_dedup(int argc, char *argv[])
         return false;
     }
 
-    if (!current || !current->q) {
+    if (no_queue()) {
         report(3, "Warning: Try to access null queue");
         return false;
     }
 
+    if (use_unrolled)
+        return unrolled_dedup();
+
     LIST_HEAD(l_copy);
     element_t *item = NULL, *tmp = NULL;
 
-    // Copy current->q to l_copy
+    // Copy current->q to l_copy, in the order of the queue
+    q_materialize(current->q);
     if (current->q && !list_empty(current->q)) {
         list_for_each_entry (item, current->q, list) {
             size_t slen;
@@ -529,20 +1023,152 @@ static bool do_dedup(int argc, char *argv[])
     return ok && !error_check();
 }
 
-static bool do_reverse(int argc, char *argv[])
+/* Set keep[i] for the elements of elems[] whose string occurs only once.
+ * Return false if out of memory.
+ */
+static bool find_unique(element_t **elems, size_t n, bool *keep)
 {
-    if (argc != 1) {
-        report(1, "%s takes no arguments", argv[0]);
+    size_t cap = 1;
+    while (cap < n)
+        cap <<= 1;
+    size_t *bucket = malloc(cap * sizeof(size_t));
+    size_t *chain = malloc(n * sizeof(size_t));
+    if (!bucket || !chain) {
+        free(bucket);
+        free(chain);
         return false;
     }
 
-    if (!current || !current->q)
+    /* Chain the elements by hash, with n marking the end of a chain */
+    for (size_t i = 0; i < cap; i++)
+        bucket[i] = n;
+    for (size_t i = 0; i < n; i++) {
+        size_t b = element_hash(elems[i]) & (cap - 1), *p = &bucket[b];
+
+        keep[i] = true;
+        for (; *p != n; p = &chain[*p]) {
+            if (!strcmp(elems[*p]->value, elems[i]->value)) {
+                keep[*p] = keep[i] = false;
+                break;
+            }
+        }
+        chain[i] = bucket[b];
+        bucket[b] = i;
+    }
+
+    free(bucket);
+    free(chain);
+    return true;
+}
+
+static bool do_hdedup(int argc, char *argv[])
+{
+    if (!list_backend(argv[0]))
+        return false;
+
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    if (!current || !current->q) {
+        report(3, "Warning: Try to access null queue");
+        return false;
+    }
+
+    /* Find out beforehand which elements should be left, and in which
+     * order. Elements are not moved by the deletion, so the ones left can
+     * be compared by address.
+     */
+    q_materialize(current->q);
+    size_t n = q_size(current->q);
+    element_t **elems = malloc((n + 1) * sizeof(element_t *));
+    bool *keep = malloc(n + 1);
+    if (!elems || !keep) {
+        free(elems);
+        free(keep);
+        report(1,
+               "INTERNAL ERROR.  Could not allocate space for duplicate "
+               "checking");
+        return false;
+    }
+    element_t *item;
+    size_t i = 0;
+    list_for_each_entry (item, current->q, list)
+        elems[i++] = item;
+    if (!find_unique(elems, n, keep)) {
+        free(elems);
+        free(keep);
+        report(1,
+               "INTERNAL ERROR.  Could not allocate space for duplicate "
+               "checking");
+        return false;
+    }
+
+    bool ok = true;
+    if (exception_setup(true))
+        ok = q_delete_dup_hash(current->q);
+    exception_cancel();
+
+    if (!ok) {
+        fail_count++;
+        if (fail_count < fail_limit) {
+            report(2, "Hash dedup failed");
+            ok = true;
+        } else {
+            report(1, "ERROR: Hash dedup failed (%d failures total)",
+                   fail_count);
+        }
+        /* The queue should be left unchanged */
+        for (i = 0; i < n; i++)
+            keep[i] = true;
+    }
+
+    bool same = true;
+    struct list_head *l_tmp = current->q->next;
+    for (i = 0; i < n; i++) {
+        if (!keep[i]) {
+            current->size--;
+            continue;
+        }
+        if (l_tmp == current->q || l_tmp != &elems[i]->list) {
+            same = false;
+            break;
+        }
+        l_tmp = l_tmp->next;
+    }
+    same = same && l_tmp == current->q;
+    if (!same) {
+        report(1,
+               "ERROR: Duplicate strings are in queue or distinct strings are "
+               "not in queue in their original order");
+        ok = false;
+    }
+
+    free(elems);
+    free(keep);
+    q_show(3);
+    return ok && !error_check();
+}
+
+static bool do_reverse(int argc, char *argv[])
+{
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    if (no_queue())
         report(3, "Warning: Calling reverse on null queue");
     error_check();
 
     set_noallocate_mode(true);
-    if (current && exception_setup(true))
-        q_reverse(current->q);
+    if (current && exception_setup(true)) {
+        if (use_unrolled)
+            uq_reverse(ctx_uq(current));
+        else
+            q_reverse(current->q);
+    }
     exception_cancel();
 
     set_noallocate_mode(false);
@@ -570,13 +1196,13 @@ static bool do_size(int argc, char *argv[])
     }
 
     int cnt = 0;
-    if (!current || !current->q)
+    if (no_queue())
         report(3, "Warning: Calling size on null queue");
     error_check();
 
     if (current && exception_setup(true)) {
         for (int r = 0; ok && r < reps; r++) {
-            cnt = q_size(current->q);
+            cnt = use_unrolled ? uq_size(ctx_uq(current)) : q_size(current->q);
             ok = ok && !error_check();
         }
     }
@@ -593,190 +1219,1114 @@ static bool do_size(int argc, char *argv[])
         }
     }
 
-    q_show(3);
+    q_show(3);
+
+    return ok && !error_check();
+}
+
+/* Ensure each element of the current queue is in ascending/descending order
+ */
+static bool check_sorted(void)
+{
+    if (!current || !current->size)
+        return true;
+
+    bool ring = q_is_ring(current->q);
+    bool back = q_is_reversed(current->q);
+    struct list_head *cur_l = back ? current->q->prev : current->q->next;
+    for (int i = 1; i < current->size; i++) {
+        element_t *item, *next_item;
+        if (ring) {
+            item = q_at(current->q, i - 1);
+            next_item = q_at(current->q, i);
+        } else {
+            item = list_entry(cur_l, element_t, list);
+            cur_l = back ? cur_l->prev : cur_l->next;
+            if (cur_l == current->q)
+                break;
+            next_item = list_entry(cur_l, element_t, list);
+        }
+        if (!descend && strcmp(item->value, next_item->value) > 0) {
+            report(1, "ERROR: Not sorted in ascending order");
+            return false;
+        }
+
+        if (descend && strcmp(item->value, next_item->value) < 0) {
+            report(1, "ERROR: Not sorted in descending order");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool do_sort(int argc, char *argv[])
+{
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    int cnt = 0;
+    if (no_queue())
+        report(3, "Warning: Calling sort on null queue");
+    else
+        cnt = use_unrolled ? uq_size(ctx_uq(current)) : q_size(current->q);
+    error_check();
+
+    if (cnt < 2)
+        report(3, "Warning: Calling sort on single node");
+    error_check();
+
+    if (current && use_unrolled)
+        return unrolled_sort();
+
+    set_noallocate_mode(true);
+    if (current && exception_setup(true))
+        q_sort(current->q, descend);
+    exception_cancel();
+    set_noallocate_mode(false);
+
+    bool ok = check_sorted();
+
+    q_show(3);
+    return ok && !error_check();
+}
+
+int cmp(void *priv, const struct list_head *a, const struct list_head *b)
+{
+    (void) priv;
+    return element_cmp(list_entry(a, element_t, list),
+                       list_entry(b, element_t, list));
+}
+
+bool do_listsort(int argc, char *argv[])
+{
+    if (!list_backend(argv[0]))
+        return false;
+
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    int cnt = 0;
+    if (!current || !current->q)
+        report(3, "Warning: Calling sort on null queue");
+    else
+        cnt = q_size(current->q);
+    error_check();
+
+    if (cnt < 2)
+        report(3, "Warning: Calling sort on single node");
+    error_check();
+
+    /* The list is sorted as it is laid out */
+    if (current)
+        q_materialize(current->q);
+
+    set_noallocate_mode(true);
+    if (current && exception_setup(true))
+        (sort_adaptive ? list_sort_adaptive : list_sort)(NULL, current->q,
+                                                         cmp);
+    if (current)
+        q_invalidate(current->q);
+    exception_cancel();
+    set_noallocate_mode(false);
+
+    bool ok = true;
+    if (current && current->size) {
+        for (struct list_head *cur_l = current->q->next;
+             cur_l != current->q && --cnt; cur_l = cur_l->next) {
+            /* Ensure each element in ascending/descending order */
+            element_t *item, *next_item;
+            item = list_entry(cur_l, element_t, list);
+            next_item = list_entry(cur_l->next, element_t, list);
+            if (!descend && strcmp(item->value, next_item->value) > 0) {
+                report(1, "ERROR: Not sorted in ascending order");
+                ok = false;
+                break;
+            }
+
+            if (descend && strcmp(item->value, next_item->value) < 0) {
+                report(1, "ERROR: Not sorted in descending order");
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    q_show(3);
+    return ok && !error_check();
+}
+
+bool do_treesort(int argc, char *argv[])
+{
+    if (!list_backend(argv[0]))
+        return false;
+
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    int cnt = 0;
+    if (!current || !current->q)
+        report(3, "Warning: Calling sort on null queue");
+    else
+        cnt = q_size(current->q);
+    error_check();
+
+    if (cnt < 2)
+        report(3, "Warning: Calling sort on single node");
+    error_check();
+
+    if (current)
+        q_materialize(current->q);
+    if (current && exception_setup(true))
+        tree_sort(current->q);
+    if (current)
+        q_invalidate(current->q);
+    exception_cancel();
+
+    bool ok = true;
+    if (current && current->size) {
+        for (struct list_head *cur_l = current->q->next;
+             cur_l != current->q && --cnt; cur_l = cur_l->next) {
+            /* Ensure each element in ascending/descending order */
+            element_t *item, *next_item;
+            item = list_entry(cur_l, element_t, list);
+            next_item = list_entry(cur_l->next, element_t, list);
+            if (!descend && strcmp(item->value, next_item->value) > 0) {
+                report(1, "ERROR: Not sorted in ascending order");
+                ok = false;
+                break;
+            }
+
+            if (descend && strcmp(item->value, next_item->value) < 0) {
+                report(1, "ERROR: Not sorted in descending order");
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    q_show(3);
+    return ok && !error_check();
+}
+
+bool do_arraysort(int argc, char *argv[])
+{
+    if (!list_backend(argv[0]))
+        return false;
+
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    int cnt = 0;
+    if (!current || !current->q)
+        report(3, "Warning: Calling sort on null queue");
+    else
+        cnt = q_size(current->q);
+    error_check();
+
+    if (cnt < 2)
+        report(3, "Warning: Calling sort on single node");
+    error_check();
+
+    if (current)
+        q_materialize(current->q);
+    bool ok = true;
+    if (current && exception_setup(true))
+        ok = array_sort(current->q, descend);
+    if (current)
+        q_invalidate(current->q);
+    exception_cancel();
+
+    if (!ok)
+        report(1, "ERROR: Could not allocate space for sorting");
+
+    ok = ok && check_sorted();
+    q_show(3);
+    return ok && !error_check();
+}
+
+bool do_radixsort(int argc, char *argv[])
+{
+    if (!list_backend(argv[0]))
+        return false;
+
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    int cnt = 0;
+    if (!current || !current->q)
+        report(3, "Warning: Calling sort on null queue");
+    else
+        cnt = q_size(current->q);
+    error_check();
+
+    if (cnt < 2)
+        report(3, "Warning: Calling sort on single node");
+    error_check();
+
+    if (current)
+        q_materialize(current->q);
+    set_noallocate_mode(true);
+    if (current && exception_setup(true))
+        radix_sort(current->q, descend);
+    if (current)
+        q_invalidate(current->q);
+    exception_cancel();
+    set_noallocate_mode(false);
+
+    bool ok = check_sorted();
+    q_show(3);
+    return ok && !error_check();
+}
+
+static bool do_dm(int argc, char *argv[])
+{
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    if (no_queue()) {
+        report(3, "Warning: Try to access null queue");
+        return false;
+    }
+    error_check();
+
+    bool ok = true;
+    if (exception_setup(true))
+        ok = use_unrolled ? uq_delete_mid(ctx_uq(current))
+                          : q_delete_mid(current->q);
+    exception_cancel();
+
+    if (!current->size)
+        report(3, "Warning: Try to delete middle node to empty queue");
+    else
+        --current->size;
+    q_show(3);
+    return ok && !error_check();
+}
+
+static bool do_insort(int argc, char *argv[])
+{
+    if (!list_backend(argv[0]))
+        return false;
+
+    char randstr_buf[MAX_RANDSTR_LEN];
+    int reps = 1;
+    bool ok = true, need_rand = false;
+    if (argc != 2 && argc != 3) {
+        report(1, "%s needs 1-2 arguments", argv[0]);
+        return false;
+    }
+
+    char *inserts = argv[1];
+    if (argc == 3) {
+        if (!get_int(argv[2], &reps)) {
+            report(1, "Invalid number of insertions '%s'", argv[2]);
+            return false;
+        }
+    }
+
+    if (!strcmp(inserts, "RAND")) {
+        need_rand = true;
+        inserts = randstr_buf;
+    }
+
+    if (!current || !current->q)
+        report(3, "Warning: Calling insert sorted %s on null queue", inserts);
+    error_check();
+
+    if (current && exception_setup(true)) {
+        for (int r = 0; ok && r < reps; r++) {
+            if (need_rand)
+                fill_rand_string(randstr_buf, sizeof(randstr_buf));
+            if (q_insert_sorted(current->q, inserts, descend)) {
+                current->size++;
+            } else {
+                fail_count++;
+                if (fail_count < fail_limit)
+                    report(2, "Insertion of %s failed", inserts);
+                else {
+                    report(1,
+                           "ERROR: Insertion of %s failed (%d failures total)",
+                           inserts, fail_count);
+                    ok = false;
+                }
+            }
+            ok = ok && !error_check();
+        }
+    }
+    exception_cancel();
+
+    ok = ok && check_sorted();
+    q_show(3);
+    return ok;
+}
+
+/* Cursor into a list, compared with the strings of an unrolled queue */
+struct walk_cmp {
+    struct list_head *head, *node;
+};
+
+static bool walk_cmp_next(const char *s, void *priv)
+{
+    struct walk_cmp *w = priv;
+    w->node = w->node->next;
+    return w->node != w->head &&
+           !strcmp(list_entry(w->node, element_t, list)->value, s);
+}
+
+static bool walk_sum(const char *s, void *priv)
+{
+    *(size_t *) priv += (unsigned char) s[0];
+    return true;
+}
+
+/* Check that the list and the unrolled queue hold the same strings */
+static bool same_strings(struct list_head *l, struct uqueue *u)
+{
+    q_materialize(l);
+    struct walk_cmp w = {l, l};
+    return uq_walk(u, walk_cmp_next, &w) && w.node->next == l;
+}
+
+#define BACKEND_PHASES 13
+#define BACKEND_K 3
+
+/* Run the same workload on a list queue and an unrolled one, checking after
+ * each phase that both hold the same strings
+ */
+static bool do_backends(int argc, char *argv[])
+{
+    static const char *phases[BACKEND_PHASES] = {
+        "insert tail", "insert head", "reverse",    "reverseK", "swap",
+        "ascend",      "sort",        "walk",       "merge",    "dedup",
+        "descend",     "remove tail", "remove head",
+    };
+    double lt[BACKEND_PHASES], ut[BACKEND_PHASES], t;
+    int n = 100000;
+
+    if (argc > 2 || (argc == 2 && (!get_int(argv[1], &n) || n < 1))) {
+        report(1, "%s takes an optional positive number of strings", argv[0]);
+        return false;
+    }
+
+    char(*strs)[MAX_RANDSTR_LEN] = malloc(n * sizeof(*strs));
+    struct list_head *l = q_new(), *l2 = q_new();
+    struct uqueue *u = uq_new(), *u2 = uq_new();
+    if (!strs || !l || !l2 || !u || !u2) {
+        report(1, "INTERNAL ERROR.  Could not allocate space for backends");
+        free(strs);
+        q_free(l);
+        q_free(l2);
+        uq_free(u);
+        uq_free(u2);
+        return false;
+    }
+    for (int i = 0; i < n; i += INSERT_BATCH) {
+        int m = n - i < INSERT_BATCH ? n - i : INSERT_BATCH;
+        fill_rand_strings(strs + i, m);
+    }
+
+    /* l and u go through all the phases, l2 and u2 are merged into them */
+    bool ok = true;
+    delta_time(&t);
+    for (int i = 0; i < n; i++)
+        ok = q_insert_tail(l, strs[i]) && ok;
+    lt[0] = delta_time(&t);
+    for (int i = 0; i < n; i++)
+        ok = uq_insert_tail(u, strs[i]) && ok;
+    ut[0] = delta_time(&t);
+    size_t lmem = q_memory(l), umem = uq_memory(u);
+    ok = ok && same_strings(l, u);
+
+    delta_time(&t);
+    for (int i = 0; i < n; i++)
+        ok = q_insert_head(l2, strs[i]) && ok;
+    lt[1] = delta_time(&t);
+    for (int i = 0; i < n; i++)
+        ok = uq_insert_head(u2, strs[i]) && ok;
+    ut[1] = delta_time(&t);
+    ok = ok && same_strings(l2, u2);
+
+    delta_time(&t);
+    q_reverse(l);
+    lt[2] = delta_time(&t);
+    uq_reverse(u);
+    ut[2] = delta_time(&t);
+    ok = ok && same_strings(l, u);
+
+    delta_time(&t);
+    q_reverseK(l, BACKEND_K);
+    lt[3] = delta_time(&t);
+    uq_reverseK(u, BACKEND_K);
+    ut[3] = delta_time(&t);
+    ok = ok && same_strings(l, u);
+
+    delta_time(&t);
+    q_swap(l);
+    lt[4] = delta_time(&t);
+    uq_swap(u);
+    ut[4] = delta_time(&t);
+    ok = ok && same_strings(l, u);
+
+    delta_time(&t);
+    int lsize = q_ascend(l2);
+    lt[5] = delta_time(&t);
+    int usize = uq_ascend(u2);
+    ut[5] = delta_time(&t);
+    ok = ok && lsize == usize && same_strings(l2, u2);
+
+    delta_time(&t);
+    q_sort(l, descend);
+    lt[6] = delta_time(&t);
+    ok = uq_sort(u, descend) && ok;
+    ut[6] = delta_time(&t);
+    q_sort(l2, descend);
+    ok = uq_sort(u2, descend) && ok;
+
+    size_t lsum = 0, usum = 0;
+    element_t *entry;
+    delta_time(&t);
+    list_for_each_entry (entry, l, list)
+        lsum += (unsigned char) entry->value[0];
+    lt[7] = delta_time(&t);
+    uq_walk(u, walk_sum, &usum);
+    ut[7] = delta_time(&t);
+    ok = ok && lsum == usum && same_strings(l, u) && same_strings(l2, u2);
+
+    queue_contex_t ctx[2] = {{.q = l}, {.q = l2}};
+    LIST_HEAD(pair);
+    list_add_tail(&ctx[0].chain, &pair);
+    list_add_tail(&ctx[1].chain, &pair);
+    delta_time(&t);
+    lsize = q_merge(&pair, descend);
+    lt[8] = delta_time(&t);
+    usize = uq_merge(u, u2, descend);
+    ut[8] = delta_time(&t);
+    ok = ok && lsize == usize && same_strings(l, u) && same_strings(l2, u2);
+
+    delta_time(&t);
+    q_delete_dup(l);
+    lt[9] = delta_time(&t);
+    uq_delete_dup(u);
+    ut[9] = delta_time(&t);
+    ok = ok && same_strings(l, u);
+
+    /* Sorted queues are left with a single string by one of ascend and
+     * descend, so the emptied second pair is refilled in random order
+     */
+    for (int i = 0; i < n; i++) {
+        ok = q_insert_tail(l2, strs[i]) && ok;
+        ok = uq_insert_tail(u2, strs[i]) && ok;
+    }
+    delta_time(&t);
+    lsize = q_descend(l2);
+    lt[10] = delta_time(&t);
+    usize = uq_descend(u2);
+    ut[10] = delta_time(&t);
+    ok = ok && lsize == usize && same_strings(l2, u2);
+
+    int half = q_size(l) / 2;
+    delta_time(&t);
+    for (int i = 0; i < half; i++)
+        q_release_element(q_remove_tail(l, NULL, 0));
+    lt[11] = delta_time(&t);
+    for (int i = 0; i < half; i++)
+        uq_remove_tail(u, NULL, 0);
+    ut[11] = delta_time(&t);
+    ok = ok && same_strings(l, u);
+
+    delta_time(&t);
+    while ((entry = q_take_head(l)))
+        q_release_element(entry);
+    lt[12] = delta_time(&t);
+    while (uq_remove_head(u, NULL, 0))
+        ;
+    ut[12] = delta_time(&t);
+
+    /* The copying removes of both backends agree too */
+    char lbuf[MAX_RANDSTR_LEN], ubuf[MAX_RANDSTR_LEN];
+    while (ok && (entry = q_remove_tail(l2, lbuf, sizeof(lbuf)))) {
+        q_release_element(entry);
+        ok = uq_remove_tail(u2, ubuf, sizeof(ubuf)) && !strcmp(lbuf, ubuf);
+    }
+    ok = ok && !uq_size(u2);
+
+    if (!ok)
+        report(1, "ERROR: The backends disagree or ran out of memory");
+    for (int i = 0; i < BACKEND_PHASES; i++)
+        report(1, "%-12s list %.3f s, unrolled %.3f s", phases[i], lt[i],
+               ut[i]);
+    report(1, "%-12s list %zu bytes, unrolled %zu bytes", "memory", lmem,
+           umem);
+
+    q_free(l);
+    q_free(l2);
+    uq_free(u);
+    uq_free(u2);
+    free(strs);
+    return ok;
+}
+
+static int cmp_cycles(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *) a, y = *(const int64_t *) b;
+    return (x > y) - (x < y);
+}
+
+/* Time every insert into a list queue and into a ring queue as they grow.
+ * A ring queue copies its array when its size reaches a power of two, so
+ * those inserts are reported apart from the others.
+ */
+static bool do_growth(int argc, char *argv[])
+{
+    int n = 100000;
+
+    if (argc > 2 || (argc == 2 && (!get_int(argv[1], &n) || n < 1))) {
+        report(1, "%s takes an optional positive number of inserts", argv[0]);
+        return false;
+    }
+
+    int64_t *cycles = malloc(n * sizeof(*cycles));
+    if (!cycles) {
+        report(1, "INTERNAL ERROR.  Could not allocate space for growth");
+        return false;
+    }
+
+    bool ok = true;
+    int saved = ring_queues;
+    for (int ring = 0; ok && ring < 2; ring++) {
+        int64_t sum = 0, max_grow = 0, max_other = 0;
+
+        ring_queues = ring;
+        struct list_head *l = q_new();
+        for (int i = 0; ok && i < n; i++) {
+            int64_t before = cpucycles();
+            ok = q_insert_tail(l, "growth");
+            cycles[i] = cpucycles() - before;
+            sum += cycles[i];
+            if (i && !(i & (i - 1)))
+                max_grow = cycles[i] > max_grow ? cycles[i] : max_grow;
+            else
+                max_other = cycles[i] > max_other ? cycles[i] : max_other;
+        }
+        q_free(l);
+        if (!ok)
+            break;
+
+        qsort(cycles, n, sizeof(*cycles), cmp_cycles);
+        report(1,
+               "%-4s mean %.1f, p99 %lld, max %lld cycles per insert "
+               "(max %lld at powers of two, %lld elsewhere)",
+               ring ? "ring" : "list", (double) sum / n,
+               (long long) cycles[n - 1 - n / 100],
+               (long long) cycles[n - 1], (long long) max_grow,
+               (long long) max_other);
+    }
+    ring_queues = saved;
+    free(cycles);
+
+    if (!ok)
+        report(1, "ERROR: Insertion failed");
+    return ok;
+}
+
+/* Work of one side of the 'spsc' benchmark */
+struct spsc_side {
+    struct spsc *q;
+    char (*strs)[MAX_RANDSTR_LEN];
+    int n;
+    int64_t *cycles; /* of each successful call */
+    long waits;      /* calls finding the queue full or empty */
+    long wrong;      /* strings removed out of order */
+};
+
+static void *spsc_producer(void *arg)
+{
+    struct spsc_side *p = arg;
+
+    for (int i = 0; i < p->n; i++) {
+        for (;;) {
+            int64_t before = cpucycles();
+            if (spsc_insert_tail(p->q, p->strs[i])) {
+                p->cycles[i] = cpucycles() - before;
+                break;
+            }
+            p->waits++;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void spsc_consumer(struct spsc_side *c)
+{
+    char buf[MAX_RANDSTR_LEN];
 
-    return ok && !error_check();
+    for (int i = 0; i < c->n; i++) {
+        for (;;) {
+            int64_t before = cpucycles();
+            if (spsc_remove_head(c->q, buf, sizeof(buf))) {
+                c->cycles[i] = cpucycles() - before;
+                break;
+            }
+            c->waits++;
+            sched_yield();
+        }
+        if (strcmp(buf, c->strs[i]))
+            c->wrong++;
+    }
 }
 
-bool do_sort(int argc, char *argv[])
+/* Hand n random strings from a producer thread over to the calling thread
+ * through a lock-free queue
+ */
+static bool do_spsc(int argc, char *argv[])
 {
-    if (argc != 1) {
-        report(1, "%s takes no arguments", argv[0]);
+    int n = 1000000, capacity = 1024;
+
+    if (argc > 3 || (argc > 1 && (!get_int(argv[1], &n) || n < 1)) ||
+        (argc > 2 && (!get_int(argv[2], &capacity) || capacity < 1))) {
+        report(1,
+               "%s takes an optional positive number of strings and "
+               "capacity",
+               argv[0]);
         return false;
     }
 
-    int cnt = 0;
-    if (!current || !current->q)
-        report(3, "Warning: Calling sort on null queue");
-    else
-        cnt = q_size(current->q);
-    error_check();
+    char(*strs)[MAX_RANDSTR_LEN] = malloc(n * sizeof(*strs));
+    int64_t *cycles = malloc(2 * n * sizeof(*cycles));
+    struct spsc *q = spsc_new(capacity);
+    if (!strs || !cycles || !q) {
+        report(1, "INTERNAL ERROR.  Could not allocate space for spsc");
+        free(strs);
+        free(cycles);
+        spsc_free(q);
+        return false;
+    }
+    for (int i = 0; i < n; i += INSERT_BATCH) {
+        int m = n - i < INSERT_BATCH ? n - i : INSERT_BATCH;
+        fill_rand_strings(strs + i, m);
+    }
 
-    if (cnt < 2)
-        report(3, "Warning: Calling sort on single node");
-    error_check();
+    struct spsc_side p = {q, strs, n, cycles, 0, 0};
+    struct spsc_side c = {q, strs, n, cycles + n, 0, 0};
+    pthread_t producer;
+    sigset_t mask, old;
+    double t;
 
-    set_noallocate_mode(true);
-    if (current && exception_setup(true))
-        q_sort(current->q, descend);
-    exception_cancel();
-    set_noallocate_mode(false);
+    /* Keep the time limit alarm away from the producer, see parallel_sort()
+     * in queue.c
+     */
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &mask, &old);
+    delta_time(&t);
+    bool threaded = !pthread_create(&producer, NULL, spsc_producer, &p);
+    if (threaded) {
+        spsc_consumer(&c);
+        pthread_join(producer, NULL);
+    }
+    double elapsed = delta_time(&t);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    bool ok = threaded && !c.wrong && !spsc_size(q);
+    if (!threaded)
+        report(1, "ERROR: Could not start the producer thread");
+    else if (!ok)
+        report(1, "ERROR: %ld strings removed out of order, %zu left", c.wrong,
+               spsc_size(q));
+    if (threaded) {
+        qsort(p.cycles, n, sizeof(*cycles), cmp_cycles);
+        qsort(c.cycles, n, sizeof(*cycles), cmp_cycles);
+        report(1, "%d strings in %.3f s, %.0f ops/s", n, elapsed,
+               2 * n / elapsed);
+        report(1,
+               "insert p99 %lld cycles, %ld waits; remove p99 %lld cycles, "
+               "%ld waits",
+               (long long) p.cycles[n - 1 - n / 100], p.waits,
+               (long long) c.cycles[n - 1 - n / 100], c.waits);
+    }
 
-    bool ok = true;
-    if (current && current->size) {
-        for (struct list_head *cur_l = current->q->next;
-             cur_l != current->q && --cnt; cur_l = cur_l->next) {
-            /* Ensure each element in ascending/descending order */
-            element_t *item, *next_item;
-            item = list_entry(cur_l, element_t, list);
-            next_item = list_entry(cur_l->next, element_t, list);
-            if (!descend && strcmp(item->value, next_item->value) > 0) {
-                report(1, "ERROR: Not sorted in ascending order");
-                ok = false;
-                break;
-            }
+    spsc_free(q);
+    free(cycles);
+    free(strs);
+    return ok;
+}
 
-            if (descend && strcmp(item->value, next_item->value) < 0) {
-                report(1, "ERROR: Not sorted in descending order");
-                ok = false;
-                break;
+/* A producer or consumer thread of the 'mpmc' stress test. Producer p of k
+ * inserts the numbers p, p + k, p + 2k... below n, so that every number is
+ * inserted once and those of each producer in ascending order.
+ */
+struct mpmc_task {
+    struct mpmc *q;
+    int id, k, n;
+    bool producer;
+    pthread_t thread;
+    bool started;
+    atomic_int *taken;  /* elements removed by all consumers */
+    atomic_uchar *seen; /* times each number was removed */
+    long waits;         /* removes finding the queue empty */
+    long disorder;      /* numbers of a producer removed out of order */
+    bool failed;        /* no handle or out of memory */
+};
+
+static void *mpmc_worker(void *arg)
+{
+    struct mpmc_task *task = arg;
+    struct mpmc_thread *t = mpmc_register(task->q);
+    char buf[16];
+
+    if (!t) {
+        task->failed = true;
+        return NULL;
+    }
+    if (task->producer) {
+        for (int i = task->id; i < task->n; i += task->k) {
+            snprintf(buf, sizeof(buf), "%d", i);
+            if (!mpmc_insert_tail(t, buf)) {
+                /* Count the rest as taken, so the consumers do not wait
+                 * for them
+                 */
+                atomic_fetch_add(task->taken, (task->n - i - 1) / task->k + 1);
+                task->failed = true;
+                return NULL;
             }
         }
+        return NULL;
     }
 
-    q_show(3);
-    return ok && !error_check();
+    int *last = malloc(task->k * sizeof(*last));
+    if (!last) {
+        task->failed = true;
+        return NULL;
+    }
+    for (int p = 0; p < task->k; p++)
+        last[p] = -1;
+    while (atomic_load(task->taken) < task->n) {
+        element_t *e = mpmc_remove_head(t, buf, sizeof(buf));
+        if (!e) {
+            task->waits++;
+            sched_yield();
+            continue;
+        }
+        atomic_fetch_add(task->taken, 1);
+        int i = atoi(buf);
+        mpmc_release_element(e);
+        if (i < 0 || i >= task->n) {
+            task->disorder++;
+            continue;
+        }
+        atomic_fetch_add(&task->seen[i], 1);
+        if (i <= last[i % task->k])
+            task->disorder++;
+        last[i % task->k] = i;
+    }
+    free(last);
+    return NULL;
 }
 
-int cmp(void *priv, const struct list_head *a, const struct list_head *b)
-{
-    (void) priv;
-    return strcmp(list_entry(a, element_t, list)->value,
-                  list_entry(b, element_t, list)->value);
-}
+/* Most producers of the mpmc command, which runs as many consumers */
+#define MPMC_MAX_PRODUCERS 32
 
-bool do_listsort(int argc, char *argv[])
+/* Pass n numbers through a queue shared by k producers and k consumers, for
+ * k from 1 to threads, checking that each number comes out exactly once
+ */
+static bool do_mpmc(int argc, char *argv[])
 {
-    if (argc != 1) {
-        report(1, "%s takes no arguments", argv[0]);
+    int n = 200000, threads = 4;
+
+    if (argc > 3 || (argc > 1 && (!get_int(argv[1], &n) || n < 1)) ||
+        (argc > 2 && (!get_int(argv[2], &threads) || threads < 1 ||
+                      threads > MPMC_MAX_PRODUCERS))) {
+        report(1,
+               "%s takes an optional positive number of strings and at "
+               "most %d producers",
+               argv[0], MPMC_MAX_PRODUCERS);
         return false;
     }
 
-    int cnt = 0;
-    if (!current || !current->q)
-        report(3, "Warning: Calling sort on null queue");
-    else
-        cnt = q_size(current->q);
-    error_check();
-
-    if (cnt < 2)
-        report(3, "Warning: Calling sort on single node");
-    error_check();
-
-    set_noallocate_mode(true);
-    if (current && exception_setup(true))
-        list_sort(NULL, current->q, cmp);
-    exception_cancel();
-    set_noallocate_mode(false);
+    atomic_uchar *seen = malloc(n * sizeof(*seen));
+    if (!seen) {
+        report(1, "INTERNAL ERROR.  Could not allocate space for mpmc");
+        return false;
+    }
 
     bool ok = true;
-    if (current && current->size) {
-        for (struct list_head *cur_l = current->q->next;
-             cur_l != current->q && --cnt; cur_l = cur_l->next) {
-            /* Ensure each element in ascending/descending order */
-            element_t *item, *next_item;
-            item = list_entry(cur_l, element_t, list);
-            next_item = list_entry(cur_l->next, element_t, list);
-            if (!descend && strcmp(item->value, next_item->value) > 0) {
-                report(1, "ERROR: Not sorted in ascending order");
-                ok = false;
-                break;
-            }
-
-            if (descend && strcmp(item->value, next_item->value) < 0) {
-                report(1, "ERROR: Not sorted in descending order");
-                ok = false;
-                break;
-            }
+    for (int k = 1; ok && k <= threads; k++) {
+        struct mpmc_task tasks[2 * MPMC_MAX_PRODUCERS];
+        struct mpmc *q = mpmc_new(2 * k);
+        atomic_int taken;
+        sigset_t mask, old;
+        double t;
+
+        if (!q) {
+            report(1, "INTERNAL ERROR.  Could not allocate space for mpmc");
+            ok = false;
+            break;
+        }
+        atomic_init(&taken, 0);
+        for (int i = 0; i < n; i++)
+            atomic_init(&seen[i], 0);
+
+        /* Consumers first, so that they are running when the producers
+         * start. A task whose thread cannot be created is run in the calling
+         * thread, after the ones of the other threads are under way. SIGALRM
+         * is blocked meanwhile, see parallel_sort() in queue.c.
+         */
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGALRM);
+        pthread_sigmask(SIG_BLOCK, &mask, &old);
+        delta_time(&t);
+        for (int i = 0; i < 2 * k; i++) {
+            tasks[i] = (struct mpmc_task){
+                .q = q,
+                .id = i % k,
+                .k = k,
+                .n = n,
+                .producer = i >= k,
+                .taken = &taken,
+                .seen = seen,
+            };
+            tasks[i].started = !pthread_create(&tasks[i].thread, NULL,
+                                               mpmc_worker, &tasks[i]);
+        }
+        for (int i = 2 * k - 1; i >= 0; i--) {
+            if (!tasks[i].started)
+                mpmc_worker(&tasks[i]);
+        }
+        for (int i = 0; i < 2 * k; i++) {
+            if (tasks[i].started)
+                pthread_join(tasks[i].thread, NULL);
+        }
+        double elapsed = delta_time(&t);
+        pthread_sigmask(SIG_SETMASK, &old, NULL);
+        mpmc_free(q);
+
+        long lost = 0, duplicated = 0, disorder = 0, waits = 0;
+        bool failed = false;
+        for (int i = 0; i < n; i++) {
+            lost += !seen[i];
+            duplicated += seen[i] > 1 ? seen[i] - 1 : 0;
         }
+        for (int i = 0; i < 2 * k; i++) {
+            disorder += tasks[i].disorder;
+            waits += tasks[i].waits;
+            failed |= tasks[i].failed;
+        }
+        report(1,
+               "%2d producers, %2d consumers: %.0f ops/s, %ld empty "
+               "removes, %ld lost, %ld duplicated, %ld out of order",
+               k, k, 2 * n / elapsed, waits, lost, duplicated, disorder);
+        if (failed)
+            report(1, "ERROR: A thread ran out of memory");
+        else if (lost || duplicated || disorder)
+            report(1, "ERROR: Numbers were lost, duplicated or reordered");
+        ok = !failed && !lost && !duplicated && !disorder;
     }
 
-    q_show(3);
-    return ok && !error_check();
+    free(seen);
+    return ok;
 }
 
-bool do_treesort(int argc, char *argv[])
+/* Ranges shorter than this are sorted by qsort() in one task */
+#define WSSORT_CUTOFF 2048
+
+/* A task of the 'wssort' benchmark, merge sorting a[0..n-1] with the help
+ * of tmp
+ */
+struct range_task {
+    struct wp_task wp;
+    char **a, **tmp;
+    size_t n;
+};
+
+static int cmp_str(const void *a, const void *b)
 {
-    if (argc != 1) {
-        report(1, "%s takes no arguments", argv[0]);
+    return strcmp(*(char *const *) a, *(char *const *) b);
+}
+
+static void range_sort(struct wp_task *wp)
+{
+    struct range_task *task = container_of(wp, struct range_task, wp);
+    char **a = task->a, **tmp = task->tmp;
+    size_t n = task->n, half = n / 2;
+
+    if (n <= WSSORT_CUTOFF) {
+        qsort(a, n, sizeof(*a), cmp_str);
+        return;
+    }
+
+    /* Let the first half be stolen and sort the second one meanwhile */
+    struct range_task left = {.a = a, .tmp = tmp, .n = half};
+    struct range_task right = {.a = a + half, .tmp = tmp + half, .n = n - half};
+    wp_task_init(&left.wp, range_sort);
+    wp_task_init(&right.wp, range_sort);
+    wp_spawn(wp, &left.wp);
+    range_sort(&right.wp);
+    wp_wait(wp);
+
+    size_t i = 0, j = half, k = 0;
+    while (i < half && j < n)
+        tmp[k++] = strcmp(a[j], a[i]) < 0 ? a[j++] : a[i++];
+    while (i < half)
+        tmp[k++] = a[i++];
+    memcpy(a, tmp, k * sizeof(*a));
+}
+
+/* Merge sort n random strings by recursive tasks on a work-stealing pool,
+ * with 1 to t threads
+ */
+static bool do_wssort(int argc, char *argv[])
+{
+    int n = 1000000, threads = 4;
+
+    if (argc > 3 || (argc > 1 && (!get_int(argv[1], &n) || n < 1)) ||
+        (argc > 2 && (!get_int(argv[2], &threads) || threads < 1 ||
+                      threads > MAX_SORT_THREADS))) {
+        report(1,
+               "%s takes an optional positive number of strings and at "
+               "most %d threads",
+               argv[0], MAX_SORT_THREADS);
         return false;
     }
 
-    int cnt = 0;
-    if (!current || !current->q)
-        report(3, "Warning: Calling sort on null queue");
-    else
-        cnt = q_size(current->q);
-    error_check();
+    char(*strs)[MAX_RANDSTR_LEN] = malloc(n * sizeof(*strs));
+    char **a = malloc(n * sizeof(*a));
+    char **tmp = malloc(n * sizeof(*tmp));
+    if (!strs || !a || !tmp) {
+        report(1, "INTERNAL ERROR.  Could not allocate space for wssort");
+        free(strs);
+        free(a);
+        free(tmp);
+        return false;
+    }
+    for (int i = 0; i < n; i += INSERT_BATCH) {
+        int m = n - i < INSERT_BATCH ? n - i : INSERT_BATCH;
+        fill_rand_strings(strs + i, m);
+    }
 
-    if (cnt < 2)
-        report(3, "Warning: Calling sort on single node");
-    error_check();
+    bool ok = true;
+    for (int t = 1; ok && t <= threads; t *= 2) {
+        struct workpool *pool = workpool_new(t);
+        if (!pool) {
+            report(1, "ERROR: Could not start %d threads", t);
+            ok = false;
+            break;
+        }
+        for (int i = 0; i < n; i++)
+            a[i] = strs[i];
+
+        struct range_task root = {.a = a, .tmp = tmp, .n = n};
+        sigset_t mask, old;
+        double elapsed;
+
+        wp_task_init(&root.wp, range_sort);
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGALRM);
+        pthread_sigmask(SIG_BLOCK, &mask, &old);
+        delta_time(&elapsed);
+        workpool_run(pool, &root.wp);
+        elapsed = delta_time(&elapsed);
+        pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+        for (int i = 1; ok && i < n; i++)
+            ok = strcmp(a[i - 1], a[i]) <= 0;
+        report(1, "threads %2d: %.3f s, %lu tasks stolen", t, elapsed,
+               workpool_steals(pool));
+        if (!ok)
+            report(1, "ERROR: Not sorted in ascending order");
+        workpool_free(pool);
+    }
+
+    free(tmp);
+    free(a);
+    free(strs);
+    return ok;
+}
 
-    if (current && exception_setup(true))
-        tree_sort(current->q);
-    exception_cancel();
+static bool do_index(int argc, char *argv[])
+{
+    if (!list_backend(argv[0]))
+        return false;
 
-    bool ok = true;
-    if (current && current->size) {
-        for (struct list_head *cur_l = current->q->next;
-             cur_l != current->q && --cnt; cur_l = cur_l->next) {
-            /* Ensure each element in ascending/descending order */
-            element_t *item, *next_item;
-            item = list_entry(cur_l, element_t, list);
-            next_item = list_entry(cur_l->next, element_t, list);
-            if (!descend && strcmp(item->value, next_item->value) > 0) {
-                report(1, "ERROR: Not sorted in ascending order");
-                ok = false;
-                break;
-            }
+    int on = 0;
 
-            if (descend && strcmp(item->value, next_item->value) < 0) {
-                report(1, "ERROR: Not sorted in descending order");
-                ok = false;
-                break;
-            }
-        }
+    if (argc != 2 || !get_int(argv[1], &on)) {
+        report(1, "%s needs 1 (index) or 0 (drop index) as argument",
+               argv[0]);
+        return false;
     }
 
-    q_show(3);
+    if (!current || !current->q) {
+        report(3, "Warning: Calling index on null queue");
+        return false;
+    }
+    error_check();
+
+    bool ok = true;
+    if (exception_setup(true))
+        ok = q_index(current->q, on);
+    exception_cancel();
+
+    if (!ok)
+        report(1, "ERROR: Could not allocate space for index");
     return ok && !error_check();
 }
 
-static bool do_dm(int argc, char *argv[])
+static bool do_at(int argc, char *argv[])
 {
-    if (argc != 1) {
-        report(1, "%s takes no arguments", argv[0]);
+    if (!list_backend(argv[0]))
+        return false;
+
+    int k = 0;
+
+    if (argc != 2 || !get_int(argv[1], &k)) {
+        report(1, "%s needs a position as argument", argv[0]);
         return false;
     }
 
     if (!current || !current->q) {
-        report(3, "Warning: Try to access null queue");
+        report(3, "Warning: Calling at on null queue");
         return false;
     }
     error_check();
 
-    bool ok = true;
+    element_t *e = NULL;
     if (exception_setup(true))
-        ok = q_delete_mid(current->q);
+        e = q_at(current->q, k);
     exception_cancel();
 
-    if (!current->size)
-        report(3, "Warning: Try to delete middle node to empty queue");
+    /* Find the expected element, walking from the head */
+    if (q_is_ring(current->q))
+        q_materialize(current->q);
+    bool back = q_is_reversed(current->q);
+    struct list_head *cur_l = back ? current->q->prev : current->q->next;
+    for (int i = 0; i < k && cur_l != current->q; i++)
+        cur_l = back ? cur_l->prev : cur_l->next;
+    element_t *expected = k < 0 || cur_l == current->q
+                              ? NULL
+                              : list_entry(cur_l, element_t, list);
+
+    if (e != expected) {
+        report(1, "ERROR: Wrong element at position %d", k);
+        return false;
+    }
+    if (e)
+        report(2, "Element at %d: %s", k, e->value);
     else
-        --current->size;
-    q_show(3);
-    return ok && !error_check();
+        report(2, "No element at %d", k);
+    return !error_check();
 }
 
 static bool do_swap(int argc, char *argv[])
@@ -786,15 +2336,19 @@ static bool do_swap(int argc, char *argv[])
         return false;
     }
 
-    if (!current || !current->q) {
+    if (no_queue()) {
         report(3, "Warning: Try to access null queue");
         return false;
     }
     error_check();
 
     set_noallocate_mode(true);
-    if (exception_setup(true))
-        q_swap(current->q);
+    if (exception_setup(true)) {
+        if (use_unrolled)
+            uq_swap(ctx_uq(current));
+        else
+            q_swap(current->q);
+    }
     exception_cancel();
 
     set_noallocate_mode(false);
@@ -811,20 +2365,23 @@ static bool do_ascend(int argc, char *argv[])
         return false;
     }
 
-    if (!current || !current->q) {
+    if (no_queue()) {
         report(3, "Warning: Calling ascend on null queue");
         return false;
     }
     error_check();
 
 
-    int cnt = q_size(current->q);
+    int cnt = use_unrolled ? uq_size(ctx_uq(current)) : q_size(current->q);
     if (!cnt)
         report(3, "Warning: Calling ascend on empty queue");
     else if (cnt < 2)
         report(3, "Warning: Calling ascend on single node");
     error_check();
 
+    if (use_unrolled)
+        return unrolled_monotonic(false);
+
     if (exception_setup(true))
         current->size = q_ascend(current->q);
     set_noallocate_mode(false);
@@ -858,20 +2415,23 @@ static bool do_descend(int argc, char *argv[])
         return false;
     }
 
-    if (!current || !current->q) {
+    if (no_queue()) {
         report(3, "Warning: Calling descend on null queue");
         return false;
     }
     error_check();
 
 
-    int cnt = q_size(current->q);
+    int cnt = use_unrolled ? uq_size(ctx_uq(current)) : q_size(current->q);
     if (!cnt)
         report(3, "Warning: Calling descend on empty queue");
     else if (cnt < 2)
         report(3, "Warning: Calling descend on single node");
     error_check();
 
+    if (use_unrolled)
+        return unrolled_monotonic(true);
+
     if (exception_setup(true))
         current->size = q_descend(current->q);
     set_noallocate_mode(false);
@@ -902,7 +2462,7 @@ static bool do_reverseK(int argc, char *argv[])
 {
     int k = 0;
 
-    if (!current || !current->q) {
+    if (no_queue()) {
         report(3, "Warning: Calling reverseK on null queue");
         return false;
     }
@@ -919,8 +2479,12 @@ static bool do_reverseK(int argc, char *argv[])
     }
 
     set_noallocate_mode(true);
-    if (exception_setup(true))
-        q_reverseK(current->q, k);
+    if (exception_setup(true)) {
+        if (use_unrolled)
+            uq_reverseK(ctx_uq(current), k);
+        else
+            q_reverseK(current->q, k);
+    }
     exception_cancel();
 
     set_noallocate_mode(false);
@@ -935,12 +2499,15 @@ static bool do_merge(int argc, char *argv[])
         return false;
     }
 
-    if (!current || !current->q) {
+    if (no_queue()) {
         report(3, "Warning: Calling merge on null queue");
         return false;
     }
     error_check();
 
+    if (use_unrolled)
+        return unrolled_merge();
+
     int len = 0;
     set_noallocate_mode(true);
     if (current && exception_setup(true))
@@ -948,7 +2515,7 @@ static bool do_merge(int argc, char *argv[])
     exception_cancel();
     set_noallocate_mode(false);
 
-    if (q_size(&chain.head) > 1) {
+    if (chain.size > 1) {
         chain.size = 1;
         current = list_entry(chain.head.next, queue_contex_t, chain);
         current->size = len;
@@ -958,7 +2525,7 @@ static bool do_merge(int argc, char *argv[])
             queue_contex_t *ctx = list_entry(cur, queue_contex_t, chain);
             cur = cur->next;
             q_free(ctx->q);
-            free(ctx);
+            free(container_of(ctx, struct chain_queue, ctx));
         }
 
         chain.head.prev = &current->chain;
@@ -967,12 +2534,16 @@ static bool do_merge(int argc, char *argv[])
 
     bool ok = true;
     if (current && current->size) {
-        for (struct list_head *cur_l = current->q->next;
-             cur_l != current->q && --len; cur_l = cur_l->next) {
+        bool back = q_is_reversed(current->q);
+        for (struct list_head *cur_l = back ? current->q->prev
+                                            : current->q->next;
+             cur_l != current->q && --len;
+             cur_l = back ? cur_l->prev : cur_l->next) {
             /* Ensure each element in ascending order */
             element_t *item, *next_item;
             item = list_entry(cur_l, element_t, list);
-            next_item = list_entry(cur_l->next, element_t, list);
+            next_item =
+                list_entry(back ? cur_l->prev : cur_l->next, element_t, list);
             if (!descend && strcmp(item->value, next_item->value) > 0) {
                 report(1,
                        "ERROR: Not sorted in ascending order (It might because "
@@ -1017,12 +2588,27 @@ static bool is_circular()
     return true;
 }
 
+/* Note the order the current queue is known to be in */
+static const char *sorted_note(void)
+{
+    bool asc = q_is_sorted(current->q, false);
+    bool desc = q_is_sorted(current->q, true);
+    if (current->size < 2 || (!asc && !desc))
+        return "";
+    if (asc && desc)
+        return " (sorted: all equal)";
+    return asc ? " (sorted: ascending)" : " (sorted: descending)";
+}
+
 static bool q_show(int vlevel)
 {
     bool ok = true;
     if (verblevel < vlevel)
         return true;
 
+    if (use_unrolled)
+        return unrolled_show(vlevel);
+
     int cnt = 0;
     if (!current || !current->q) {
         report(vlevel, "l = NULL");
@@ -1037,11 +2623,14 @@ static bool q_show(int vlevel)
     report_noreturn(vlevel, "l = [");
 
     struct list_head *ori = current->q;
-    struct list_head *cur = current->q->next;
+    bool ring = q_is_ring(current->q);
+    bool back = q_is_reversed(current->q);
+    struct list_head *cur = back ? current->q->prev : current->q->next;
 
     if (exception_setup(true)) {
-        while (ok && ori != cur && cnt < current->size) {
-            element_t *e = list_entry(cur, element_t, list);
+        while (ok && (ring || ori != cur) && cnt < current->size) {
+            element_t *e = ring ? q_at(current->q, cnt)
+                                : list_entry(cur, element_t, list);
             if (cnt < BIG_LIST_SIZE) {
                 report_noreturn(vlevel, cnt == 0 ? "%s" : " %s", e->value);
                 if (show_entropy) {
@@ -1051,7 +2640,7 @@ static bool q_show(int vlevel)
                 }
             }
             cnt++;
-            cur = cur->next;
+            cur = back ? cur->prev : cur->next;
             ok = ok && !error_check();
         }
     }
@@ -1062,11 +2651,11 @@ static bool q_show(int vlevel)
         return false;
     }
 
-    if (cur == ori) {
+    if (ring || cur == ori) {
         if (cnt <= BIG_LIST_SIZE)
-            report(vlevel, "]");
+            report(vlevel, "]%s", sorted_note());
         else
-            report(vlevel, " ... ]");
+            report(vlevel, " ... ]%s", sorted_note());
     } else {
         report(vlevel, " ... ]");
         report(vlevel, "ERROR:  Queue has more than %d elements",
@@ -1090,6 +2679,20 @@ static bool do_show(int argc, char *argv[])
     return q_show(0);
 }
 
+static bool do_stats(int argc, char *argv[])
+{
+    if (argc != 1) {
+        report(1, "%s takes no arguments", argv[0]);
+        return false;
+    }
+
+    report(1, "Sorts: %lu done, %lu skipped on sorted queues", q_stats.sorts,
+           q_stats.sorts_skipped);
+    report(1, "Merges: %lu pairs merged, %lu pairs concatenated",
+           q_stats.merges, q_stats.merges_skipped);
+    return true;
+}
+
 static bool do_prev(int argc, char *argv[])
 {
     if (argc != 1) {
@@ -1138,6 +2741,9 @@ static bool do_next(int argc, char *argv[])
 
 static bool do_shuffle(int argc, char *argv[])
 {
+    if (!list_backend(argv[0]))
+        return false;
+
     if (argc != 1) {
         report(1, "%s takes no arguments", argv[0]);
         return false;
@@ -1154,11 +2760,21 @@ static bool do_shuffle(int argc, char *argv[])
         report(3, "Warning: Calling shuffle on single node");
     error_check();
 
-    set_noallocate_mode(true);
+    /* The blockwise shuffle must not allocate at all. The default one
+     * gathers the nodes into an array, which it has to allocate, so it is
+     * only checked to free that array again.
+     */
+    size_t blocks = allocation_check();
+    if (shuffle_noalloc)
+        set_noallocate_mode(true);
     if (current && exception_setup(true))
         q_shuffle(current->q);
     exception_cancel();
     set_noallocate_mode(false);
+    if (allocation_check() != blocks) {
+        report(1, "ERROR: Shuffle did not free all the memory it allocated");
+        return false;
+    }
 
 
     return q_show(3) && !error_check();
@@ -1346,16 +2962,63 @@ static void console_init()
         rt,
         "Remove from tail of queue. Optionally compare to expected value str",
         "[str]");
+    ADD_COMMAND(th, "Take from head of queue, without copying its string",
+                "");
+    ADD_COMMAND(tt, "Take from tail of queue, without copying its string",
+                "");
     ADD_COMMAND(reverse, "Reverse queue", "");
     ADD_COMMAND(sort, "Sort queue in ascending/descening order", "");
     ADD_COMMAND(listsort,
                 "Sort queue in ascending/descening order with listsort", "");
     ADD_COMMAND(treesort,
                 "Sort queue in ascending/descening order with tree sort", "");
+    ADD_COMMAND(arraysort,
+                "Sort queue in ascending/descening order through an array of "
+                "its elements",
+                "");
+    ADD_COMMAND(radixsort,
+                "Sort queue in ascending/descening order with MSD radix sort",
+                "");
     ADD_COMMAND(size, "Compute queue size n times (default: n == 1)", "[n]");
     ADD_COMMAND(show, "Show queue contents", "");
+    ADD_COMMAND(stats, "Show how many sorts and merges were skipped", "");
     ADD_COMMAND(dm, "Delete middle node in queue", "");
+    ADD_COMMAND(insort,
+                "Insert string str into a sorted queue n times, in "
+                "ascending/descending order. Generate random string(s) if str "
+                "equals RAND. (default: n == 1)",
+                "str [n]");
+    ADD_COMMAND(backends,
+                "Compare the list queue with an unrolled list on n random "
+                "strings (default: n == 100000)",
+                "[n]");
+    ADD_COMMAND(growth,
+                "Time each of n inserts into a list queue and a ring queue "
+                "(default: n == 100000)",
+                "[n]");
+    ADD_COMMAND(spsc,
+                "Hand n random strings from one thread over to another "
+                "through a lock-free queue holding up to c of them "
+                "(default: n == 1000000, c == 1024)",
+                "[n] [c]");
+    ADD_COMMAND(mpmc,
+                "Pass n numbers through a lock-free queue shared by k "
+                "producers and k consumers, for k from 1 to t "
+                "(default: n == 200000, t == 4)",
+                "[n] [t]");
+    ADD_COMMAND(wssort,
+                "Merge sort n random strings by recursive tasks on a "
+                "work-stealing pool of 1, 2, 4... up to t threads "
+                "(default: n == 1000000, t == 4)",
+                "[n] [t]");
+    ADD_COMMAND(index, "Keep (1) or drop (0) a position index over the queue",
+                "[1|0]");
+    ADD_COMMAND(at, "Show the element at position k of the queue", "[k]");
     ADD_COMMAND(dedup, "Delete all nodes that have duplicate string", "");
+    ADD_COMMAND(hdedup,
+                "Delete all nodes that have duplicate string, without "
+                "sorting",
+                "");
     ADD_COMMAND(merge, "Merge all the queues into one sorted queue", "");
     ADD_COMMAND(swap, "Swap every two adjacent nodes in queue", "");
     ADD_COMMAND(ascend,
@@ -1383,6 +3046,18 @@ static void console_init()
               "Number of times allow queue operations to return false", NULL);
     add_param("descend", &descend,
               "Sort and merge queue in ascending/descending order", NULL);
+    add_param("threads", &sort_threads,
+              "Number of threads used by sort and merge", NULL);
+    add_param("gallop", &merge_gallop,
+              "Wins in a row before a merge gallops, 0 to disable", NULL);
+    add_param("noalloc-shuffle", &shuffle_noalloc,
+              "Shuffle block-wise without allocating", NULL);
+    add_param("adaptive", &sort_adaptive,
+              "Detect already ordered runs in sort and listsort", NULL);
+    add_param("lazy-reverse", &lazy_reverse,
+              "Reverse by flipping the direction of the queue", NULL);
+    add_param("ring", &ring_queues,
+              "Keep the elements of new queues in a growable array", NULL);
 }
 
 /* Signal handlers */
@@ -1423,14 +3098,18 @@ static bool q_quit(int argc, char *argv[])
         while (chain.size > 0) {
             queue_contex_t *qctx = list_entry(cur, queue_contex_t, chain);
             cur = cur->next;
-            q_free(qctx->q);
-            free(qctx);
+            if (use_unrolled)
+                uq_free(ctx_uq(qctx));
+            else
+                q_free(qctx->q);
+            free(container_of(qctx, struct chain_queue, ctx));
             chain.size--;
         }
     }
 
     exception_cancel();
     set_cautious_mode(true);
+    q_pool_free();
 
     size_t bcnt = allocation_check();
     if (bcnt > 0) {
@@ -1444,11 +3123,14 @@ static bool q_quit(int argc, char *argv[])
 
 static void usage(char *cmd)
 {
-    printf("Usage: %s [-h] [-f IFILE][-v VLEVEL][-l LFILE]\n", cmd);
+    printf("Usage: %s [-h] [-f IFILE][-v VLEVEL][-l LFILE][-b BACKEND]\n",
+           cmd);
     printf("\t-h         Print this information\n");
     printf("\t-f IFILE   Read commands from IFILE\n");
     printf("\t-v VLEVEL  Set verbosity level\n");
     printf("\t-l LFILE   Echo results to LFILE\n");
+    printf("\t-b BACKEND Keep queues as 'list' queues (default) or 'unrolled'\n");
+    printf("\t           lists, see unrolled.h\n");
     exit(0);
 }
 
@@ -1519,7 +3201,7 @@ int main(int argc, char *argv[])
     int level = 4;
     int c;
 
-    while ((c = getopt(argc, argv, "hv:f:l:")) != -1) {
+    while ((c = getopt(argc, argv, "hv:f:l:b:")) != -1) {
         switch (c) {
         case 'h':
             usage(argv[0]);
@@ -1544,6 +3226,14 @@ int main(int argc, char *argv[])
             buf[BUFSIZE - 1] = '\0';
             logfile_name = lbuf;
             break;
+        case 'b':
+            if (!strcmp(optarg, "unrolled")) {
+                use_unrolled = true;
+            } else if (strcmp(optarg, "list")) {
+                fprintf(stderr, "Unknown backend '%s'\n", optarg);
+                exit(EXIT_FAILURE);
+            }
+            break;
         default:
             printf("Unknown option '%c'\n", c);
             usage(argv[0]);
@@ -1,18 +1,33 @@
+#include <assert.h>
+#include <pthread.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "list_sort.h"
 #include "queue.h"
+#include "random.h"
+#include "workpool.h"
 
 /**
  * q_shuffle() - Shuffle elements of queue
  * @head: header of queue
  *
  * No effect if queue is NULL or empty. If there has only one element, do
- * nothing.
+ * nothing. All permutations are equally likely. The nodes are gathered into
+ * an array for a Fisher-Yates shuffle in O(n) time, unless shuffle_noalloc
+ * is set or the array cannot be allocated, in which case a slower block-wise
+ * shuffle which does not allocate is used.
  */
 void q_shuffle(struct list_head *head);
 
+int sort_adaptive = 0;
+int sort_threads = 1;
+int shuffle_noalloc = 0;
+int lazy_reverse = 0;
+int ring_queues = 0;
+struct q_stats q_stats;
 
 /* Notice: sometimes, Cppcheck would find the potential NULL pointer bugs,
  * but some of them cannot occur. You can suppress them by adding the
@@ -21,13 +36,550 @@ void q_shuffle(struct list_head *head);
  */
 
 
+/* Elements are bump-allocated from slabs of SLAB_SIZE bytes owned by the
+ * queue, so that inserting usually does not call malloc at all and q_free()
+ * releases a whole slab at a time.
+ */
+#define SLAB_SIZE 16384
+#define SLAB_ALIGN(n) (((n) + sizeof(long) - 1) & ~(sizeof(long) - 1))
+
+typedef struct queue queue_t;
+
+/**
+ * struct q_slab - Chunk of memory elements are carved out of
+ * @link: node in the slab list of the owning queue
+ * @owner: the owning queue, NULL once the queue has been freed
+ * @used: number of bytes of @data handed out so far
+ * @live: number of elements not released yet
+ * @detached: number of removed elements the caller has not released yet
+ * @data: storage for elements
+ *
+ * Memory of released elements is not reused. The slab is freed as soon as
+ * @live drops to zero, unless it is the one the queue allocates from.
+ */
+struct q_slab {
+    struct list_head link;
+    queue_t *owner;
+    size_t used;
+    int live;
+    int detached;
+    char data[];
+};
+
+#define SLAB_CAPACITY (SLAB_SIZE - sizeof(struct q_slab))
+
+/**
+ * struct queue - Header of a queue
+ * @head: list of elements, must be the first member since q_new() returns it
+ * @slabs: slabs holding the elements of this queue
+ * @cur: slab new elements are allocated from
+ * @size: number of elements in the queue
+ * @heap_values: number of elements whose string is allocated separately
+ * @reversed: the queue runs from the last node of @head to the first one
+ * @sorted: SORTED_ASC and/or SORTED_DESC if the queue is known to be sorted
+ *          in that order, from its head to its tail
+ * @ring: array of ring_mask + 1 pointers holding the elements of a ring
+ *        queue, from slot @ring_first on, while @head stays empty. NULL for
+ *        list queues.
+ * @ring_array: the array of a ring queue, kept after it becomes a list queue
+ *              until the queue is freed, since that may happen in
+ *              operations which must not call free()
+ */
+struct queue {
+    struct list_head head;
+    struct list_head slabs;
+    struct q_slab *cur;
+    int size;
+    int heap_values;
+    bool reversed;
+    int sorted;
+    struct q_index *index; /* NULL unless the queue is indexed */
+    element_t **ring, **ring_array;
+    unsigned int ring_first, ring_mask;
+};
+
+#define to_queue(h) container_of(h, queue_t, head)
+
+#define SORTED_ASC 1
+#define SORTED_DESC 2
+#define SORTED_BOTH (SORTED_ASC | SORTED_DESC)
+#define sorted_order(descend) ((descend) ? SORTED_DESC : SORTED_ASC)
+
+/* Forget the order of queue q, which is still sorted if it is too short to
+ * be out of order
+ */
+static void sorted_reset(queue_t *q, int sorted)
+{
+    q->sorted = q->size < 2 ? SORTED_BOTH : sorted;
+}
+
+/* Start a new slab to allocate from. The previous one is freed if all its
+ * elements are gone already.
+ */
+static struct q_slab *slab_new(queue_t *q)
+{
+    struct q_slab *slab = malloc(SLAB_SIZE);
+    if (!slab)
+        return NULL;
+    slab->owner = q;
+    slab->used = 0;
+    slab->live = 0;
+    slab->detached = 0;
+    list_add(&slab->link, &q->slabs);
+
+    struct q_slab *old = q->cur;
+    q->cur = slab;
+    if (old && !old->live) {
+        list_del(&old->link);
+        free(old);
+    }
+    return slab;
+}
+
+static element_t *slab_alloc(queue_t *q, size_t size)
+{
+    size = SLAB_ALIGN(size);
+    if ((!q->cur || q->cur->used + size > SLAB_CAPACITY) && !slab_new(q))
+        return NULL;
+
+    struct q_slab *slab = q->cur;
+    element_t *e = (element_t *) (slab->data + slab->used);
+    slab->used += size;
+    slab->live++;
+    e->slab = slab;
+    return e;
+}
+
+/* Drop a reference to the slab of a released element */
+static void slab_put(struct q_slab *slab)
+{
+    if (--slab->live)
+        return;
+    if (slab->owner) {
+        if (slab == slab->owner->cur)
+            return;
+        list_del(&slab->link);
+    }
+    free(slab);
+}
+
+/* Hand the slabs and counters of @from over to @to, after every element of
+ * @from has been moved into @to. Nothing is freed since this runs while
+ * merging queues.
+ */
+static void queue_adopt(queue_t *to, queue_t *from)
+{
+    struct q_slab *slab;
+    list_for_each_entry (slab, &from->slabs, link)
+        slab->owner = to;
+    list_splice_tail_init(&from->slabs, &to->slabs);
+    from->cur = NULL;
+    to->size += from->size;
+    from->size = 0;
+    to->heap_values += from->heap_values;
+    from->heap_values = 0;
+}
+
+/* Compare two elements in the order of a sort, ascending unless descend */
+static inline int cmp_elements(const element_t *a,
+                               const element_t *b,
+                               bool descend)
+{
+    int r = element_cmp(a, b);
+    return descend ? -r : r;
+}
+
+/* Position index: an indexable skip list whose nodes point to the elements
+ * in queue order. Each link records how many positions it skips, so the
+ * element at any position is reached in O(log n) expected steps.
+ *
+ * Inserting and removing at either end and q_delete_mid() keep the index in
+ * step with the list. Every other change only marks it stale, and the next
+ * positional operation resizes it and relabels its nodes in one pass. Index
+ * nodes are never handed back to free() before the index itself is dropped,
+ * so operations running under noallocate mode can safely mark it stale.
+ */
+#define SKIP_MAX_LEVEL 16
+#define INDEX_CHUNK 16384
+
+struct skip_node;
+
+struct skip_link {
+    struct skip_node *next;
+    size_t width; /* Positions from this node to next, unused if next is
+                   * NULL */
+};
+
+struct skip_node {
+    element_t *e;
+    int level;
+    struct skip_link link[];
+};
+
+struct index_chunk {
+    struct index_chunk *next;
+    char data[];
+};
+
+/**
+ * struct q_index - Position index of a queue
+ * @head: links of the header, which is at position 0, the first element is
+ *        at position 1
+ * @level: number of levels in use
+ * @size: number of nodes
+ * @stale: set once the list changed in a way the index does not track
+ * @seed: state of the generator of node levels
+ * @free: released nodes, by level
+ * @chunks: memory the nodes are carved out of
+ * @bump: next free byte of the newest chunk
+ * @left: bytes left after @bump
+ */
+struct q_index {
+    struct skip_link head[SKIP_MAX_LEVEL];
+    int level;
+    size_t size;
+    bool stale;
+    uint64_t seed;
+    struct skip_node *free[SKIP_MAX_LEVEL];
+    struct index_chunk *chunks;
+    char *bump;
+    size_t left;
+};
+
+static void index_stale(queue_t *q)
+{
+    if (q->index)
+        q->index->stale = true;
+}
+
+/* Get a node with a random level, each level being 4 times rarer than the
+ * one below. Return NULL if out of memory.
+ */
+static struct skip_node *index_node(struct q_index *ix)
+{
+    ix->seed ^= ix->seed << 13;
+    ix->seed ^= ix->seed >> 7;
+    ix->seed ^= ix->seed << 17;
+    int level = 1 + __builtin_ctzll(ix->seed | 1ULL << 62) / 2;
+    if (level > SKIP_MAX_LEVEL)
+        level = SKIP_MAX_LEVEL;
+
+    struct skip_node *node = ix->free[level - 1];
+    if (node) {
+        ix->free[level - 1] = node->link[0].next;
+        return node;
+    }
+
+    size_t size = sizeof(*node) + level * sizeof(struct skip_link);
+    if (ix->left < size) {
+        struct index_chunk *chunk = malloc(INDEX_CHUNK);
+        if (!chunk)
+            return NULL;
+        chunk->next = ix->chunks;
+        ix->chunks = chunk;
+        ix->bump = chunk->data;
+        ix->left = INDEX_CHUNK - sizeof(*chunk);
+    }
+    node = (struct skip_node *) ix->bump;
+    ix->bump += size;
+    ix->left -= size;
+    node->level = level;
+    return node;
+}
+
+/* Find, on each level, the last links before position pos, and the
+ * positions they start at
+ */
+static void index_seek(struct q_index *ix,
+                       size_t pos,
+                       struct skip_link **update,
+                       size_t *rank)
+{
+    struct skip_link *x = ix->head;
+    size_t at = 0;
+
+    for (int lvl = ix->level - 1; lvl >= 0; lvl--) {
+        while (x[lvl].next && at + x[lvl].width < pos) {
+            at += x[lvl].width;
+            x = x[lvl].next->link;
+        }
+        update[lvl] = x;
+        rank[lvl] = at;
+    }
+}
+
+/* Insert a node for e at position pos, from 1 to size + 1 */
+static bool index_insert(struct q_index *ix, size_t pos, element_t *e)
+{
+    struct skip_link *update[SKIP_MAX_LEVEL];
+    size_t rank[SKIP_MAX_LEVEL];
+    struct skip_node *node = index_node(ix);
+    if (!node)
+        return false;
+
+    node->e = e;
+    index_seek(ix, pos, update, rank);
+    for (; ix->level < node->level; ix->level++) {
+        update[ix->level] = ix->head;
+        rank[ix->level] = 0;
+        ix->head[ix->level].next = NULL;
+    }
+    for (int lvl = 0; lvl < ix->level; lvl++) {
+        struct skip_link *u = &update[lvl][lvl];
+        if (lvl < node->level) {
+            node->link[lvl].next = u->next;
+            node->link[lvl].width = rank[lvl] + u->width + 1 - pos;
+            u->next = node;
+            u->width = pos - rank[lvl];
+        } else {
+            u->width++;
+        }
+    }
+    ix->size++;
+    return true;
+}
+
+/* Remove the node at position pos, from 1 to size, and return its element */
+static element_t *index_remove(struct q_index *ix, size_t pos)
+{
+    struct skip_link *update[SKIP_MAX_LEVEL];
+    size_t rank[SKIP_MAX_LEVEL];
+
+    index_seek(ix, pos, update, rank);
+    struct skip_node *node = update[0][0].next;
+    for (int lvl = 0; lvl < ix->level; lvl++) {
+        struct skip_link *u = &update[lvl][lvl];
+        if (lvl < node->level) {
+            u->width += node->link[lvl].width - 1;
+            u->next = node->link[lvl].next;
+        } else {
+            u->width--;
+        }
+    }
+    while (ix->level > 0 && !ix->head[ix->level - 1].next)
+        ix->level--;
+    ix->size--;
+
+    node->link[0].next = ix->free[node->level - 1];
+    ix->free[node->level - 1] = node;
+    return node->e;
+}
+
+/* Return the element at position pos, from 1 to size */
+static element_t *index_at(struct q_index *ix, size_t pos)
+{
+    struct skip_link *x = ix->head;
+    size_t at = 0;
+
+    for (int lvl = ix->level - 1; lvl >= 0; lvl--) {
+        while (x[lvl].next && at + x[lvl].width <= pos) {
+            at += x[lvl].width;
+            if (at == pos)
+                return x[lvl].next->e;
+            x = x[lvl].next->link;
+        }
+    }
+    return NULL;
+}
+
+/* Bring a stale index of queue q up to date: add or remove nodes at the end
+ * until there is one per element, then relabel all of them. Return false if
+ * there is no index or it could not be grown.
+ */
+static bool index_sync(queue_t *q)
+{
+    struct q_index *ix = q->index;
+    if (!ix)
+        return false;
+    if (!ix->stale)
+        return true;
+
+    while (ix->size > q->size)
+        index_remove(ix, ix->size);
+    while (ix->size < q->size) {
+        if (!index_insert(ix, ix->size + 1, NULL))
+            return false;
+    }
+
+    struct skip_node *node = ix->head[0].next;
+    element_t *entry;
+    list_for_each_entry (entry, &q->head, list) {
+        node->e = entry;
+        node = node->link[0].next;
+    }
+    ix->stale = false;
+    return true;
+}
+
+static void index_free(struct q_index *ix)
+{
+    while (ix->chunks) {
+        struct index_chunk *next = ix->chunks->next;
+        free(ix->chunks);
+        ix->chunks = next;
+    }
+    free(ix);
+}
+
+/* Maintain a position index over the queue, or drop it */
+bool q_index(struct list_head *head, bool on)
+{
+    if (!head)
+        return false;
+
+    queue_t *q = to_queue(head);
+    if (!on) {
+        if (q->index)
+            index_free(q->index);
+        q->index = NULL;
+        return true;
+    }
+    if (q->index)
+        return true;
+
+    struct q_index *ix = malloc(sizeof(*ix));
+    if (!ix)
+        return false;
+    memset(ix, 0, sizeof(*ix));
+    ix->seed = (uintptr_t) ix | 1;
+    ix->stale = true;
+    q->index = ix;
+    return true;
+}
+
+/* Tell the queue that its list was changed outside of this API */
+void q_invalidate(struct list_head *head)
+{
+    if (!head)
+        return;
+    index_stale(to_queue(head));
+    sorted_reset(to_queue(head), 0);
+}
+
+/* Ring queues keep pointers to their elements in a circular array whose
+ * size is a power of two, so both ends are reached by masking an offset.
+ * The array doubles when full, copying the pointers in order, which makes
+ * inserting O(1) amortized rather than in the worst case. The elements are
+ * still allocated from slabs, but are not linked into the list.
+ *
+ * Only the operations at the ends and q_at() work on the array. Any other
+ * one first unpacks the queue, linking the elements into the list and
+ * turning it into a list queue for good.
+ */
+#define RING_MIN 16
+
+/* Slot of the element k places after the first one in the array */
+static inline element_t **ring_slot(queue_t *q, unsigned int k)
+{
+    return &q->ring[(q->ring_first + k) & q->ring_mask];
+}
+
+/* Make room for one more element. Return false if out of memory. */
+static bool ring_grow(queue_t *q)
+{
+    unsigned int cap = q->ring_mask + 1;
+    if (q->size < cap)
+        return true;
+
+    element_t **ring = malloc(2 * cap * sizeof(*ring));
+    if (!ring)
+        return false;
+    for (unsigned int k = 0; k < cap; k++)
+        ring[k] = *ring_slot(q, k);
+    free(q->ring);
+    q->ring = q->ring_array = ring;
+    q->ring_first = 0;
+    q->ring_mask = 2 * cap - 1;
+    return true;
+}
+
+/* Turn ring queue q into a list queue, without freeing its array */
+static void ring_unpack(queue_t *q)
+{
+    if (!q->ring)
+        return;
+    for (int k = 0; k < q->size; k++)
+        list_add_tail(&(*ring_slot(q, k))->list, &q->head);
+    q->ring = NULL;
+    index_stale(q);
+}
+
+/* Return the first (last false) or last element of queue q in memory */
+static element_t *end_element(queue_t *q, bool last)
+{
+    if (q->ring)
+        return *ring_slot(q, last ? q->size - 1 : 0);
+    return list_entry(last ? q->head.prev : q->head.next, element_t, list);
+}
+
+/* Return the number of bytes allocated for queue */
+size_t q_memory(struct list_head *head)
+{
+    if (!head)
+        return 0;
+
+    queue_t *q = to_queue(head);
+    size_t bytes = sizeof(queue_t);
+    struct q_slab *slab;
+    list_for_each_entry (slab, &q->slabs, link)
+        bytes += SLAB_SIZE;
+    if (q->ring_array)
+        bytes += (q->ring_mask + 1) * sizeof(*q->ring_array);
+    for (int k = 0; q->ring && q->heap_values && k < q->size; k++) {
+        element_t *entry = *ring_slot(q, k);
+        if (entry->value != entry->inline_value)
+            bytes += strlen(entry->value) + 1;
+    }
+    if (q->heap_values) {
+        element_t *entry;
+        list_for_each_entry (entry, head, list) {
+            if (entry->value != entry->inline_value)
+                bytes += strlen(entry->value) + 1;
+        }
+    }
+    if (q->index) {
+        bytes += sizeof(*q->index);
+        for (struct index_chunk *c = q->index->chunks; c; c = c->next)
+            bytes += INDEX_CHUNK;
+    }
+    return bytes;
+}
+
 /* Create an empty queue */
 struct list_head *q_new()
 {
-    struct list_head *head = malloc(sizeof(struct list_head));
-    if (head)
-        INIT_LIST_HEAD(head);
-    return head;
+    queue_t *q = malloc(sizeof(queue_t));
+    if (!q)
+        return NULL;
+    INIT_LIST_HEAD(&q->head);
+    INIT_LIST_HEAD(&q->slabs);
+    q->cur = NULL;
+    q->size = 0;
+    q->heap_values = 0;
+    q->reversed = false;
+    q->sorted = SORTED_BOTH;
+    q->index = NULL;
+    q->ring = NULL;
+    q->ring_first = 0;
+    q->ring_mask = RING_MIN - 1;
+    if (ring_queues) {
+        q->ring = malloc(RING_MIN * sizeof(*q->ring));
+        if (!q->ring) {
+            free(q);
+            return NULL;
+        }
+    }
+    q->ring_array = q->ring;
+
+    /* Allocate the first slab up front so inserting into a new queue costs
+     * the same as inserting into a populated one.
+     */
+    if (!slab_new(q)) {
+        free(q->ring);
+        free(q);
+        return NULL;
+    }
+    return &q->head;
 }
 
 /* Free all storage used by queue */
@@ -35,41 +587,135 @@ void q_free(struct list_head *head)
 {
     if (!head)
         return;
-    element_t *entry, *safe;
-    list_for_each_entry_safe (entry, safe, head, list) {
-        q_release_element(entry);
+    queue_t *q = to_queue(head);
+    if (q->index)
+        index_free(q->index);
+    ring_unpack(q);
+    free(q->ring_array);
+    if (q->heap_values) {
+        element_t *entry;
+        list_for_each_entry (entry, head, list) {
+            if (entry->value != entry->inline_value)
+                free(entry->value);
+        }
+    }
+
+    /* Slabs with removed elements which are not released yet have to stay
+     * until q_release_element() is called on those.
+     */
+    struct q_slab *slab, *safe;
+    list_for_each_entry_safe (slab, safe, &q->slabs, link) {
+        if (slab->detached) {
+            slab->owner = NULL;
+            slab->live = slab->detached;
+        } else {
+            free(slab);
+        }
     }
-    free(head);
-    return;
+    free(q);
 }
 
 /*
- * New an element for s,
- * It will allocate memory for s
+ * New an element for s in queue q,
+ * Short strings are copied into the element itself. Longer ones get their
+ * own copy.
  * Return null if allocation failed.
  */
-element_t *new_element(char *s)
+static element_t *new_element(queue_t *q, char *s)
 {
-    element_t *new = malloc(sizeof(element_t));
+    size_t len = strlen(s) + 1;
+    bool inlined = len <= ELEMENT_INLINE_SIZE;
+    element_t *new = slab_alloc(q, sizeof(element_t) + (inlined ? len : 0));
     if (!new)
         return NULL;
+    new->key = element_key(s);
+    if (inlined) {
+        new->value = memcpy(new->inline_value, s, len);
+        return new;
+    }
     new->value = strdup(s);
     if (!new->value) {
-        free(new);
+        slab_put(new->slab);
         return NULL;
     }
+    q->heap_values++;
     return new;
 }
 
+/* Release an element which has been unlinked from queue q */
+static void delete_element(queue_t *q, element_t *e)
+{
+    if (e->value != e->inline_value) {
+        free(e->value);
+        q->heap_values--;
+    }
+    q->size--;
+    if (q->size < 2)
+        q->sorted = SORTED_BOTH;
+    slab_put(e->slab);
+}
+
+/* Release an element returned by q_remove_head() or q_remove_tail() */
+void q_release_element(element_t *e)
+{
+    if (e->value != e->inline_value)
+        free(e->value);
+    e->slab->detached--;
+    slab_put(e->slab);
+}
+
+/* Clear the orders of queue q broken by adding new next to element next,
+ * after it in the order of the queue if after is true
+ */
+static void sorted_add(queue_t *q,
+                       const element_t *next,
+                       const element_t *new,
+                       bool after)
+{
+    int r = after ? element_cmp(next, new) : element_cmp(new, next);
+    if (r > 0)
+        q->sorted &= ~SORTED_ASC;
+    else if (r < 0)
+        q->sorted &= ~SORTED_DESC;
+}
+
+/* Link a new element at the first (tail false) or last node of queue q. A
+ * ring queue must have room for it.
+ */
+static void add_element(queue_t *q, element_t *new, bool tail)
+{
+    if (q->size)
+        sorted_add(q, end_element(q, tail), new, tail != q->reversed);
+
+    if (q->ring) {
+        if (!tail)
+            q->ring_first = (q->ring_first - 1) & q->ring_mask;
+        *ring_slot(q, tail ? q->size : 0) = new;
+        q->size++;
+        return;
+    }
+    if (tail)
+        list_add_tail(&new->list, &q->head);
+    else
+        list_add(&new->list, &q->head);
+    q->size++;
+    if (q->index && !q->index->stale &&
+        !index_insert(q->index, tail ? q->size : 1, new))
+        q->index->stale = true;
+}
+
 /* Insert an element at head of queue */
 bool q_insert_head(struct list_head *head, char *s)
 {
     if (!head)
         return false;
-    element_t *new = new_element(s);
+    queue_t *q = to_queue(head);
+    if (q->ring && !ring_grow(q))
+        return false;
+    element_t *new = new_element(q, s);
     if (!new)
         return false;
-    list_add(&new->list, head);
+    add_element(q, new, q->reversed);
     return true;
 }
 
@@ -78,34 +724,220 @@ bool q_insert_tail(struct list_head *head, char *s)
 {
     if (!head)
         return false;
-    element_t *new = new_element(s);
+    queue_t *q = to_queue(head);
+    if (q->ring && !ring_grow(q))
+        return false;
+    element_t *new = new_element(q, s);
     if (!new)
         return false;
-    list_add_tail(&new->list, head);
+    add_element(q, new, !q->reversed);
     return true;
 }
 
-/* Remove an element from head of queue */
-element_t *q_remove_head(struct list_head *head, char *sp, size_t bufsize)
+/* Insert n strings as n calls to q_insert_head() (tail false) or
+ * q_insert_tail() would. The elements are linked into a chain of their own,
+ * which is spliced into the queue at once.
+ */
+static int insert_batch(struct list_head *head, char **s, int n, bool tail)
 {
-    if (!head || head == head->prev)
-        return NULL;
-    element_t *temp = list_first_entry(head, element_t, list);
-    if (sp) {
-        memcpy(sp, temp->value, bufsize);
-        *(sp + bufsize - 1) = '\0';
+    if (!head)
+        return 0;
+    queue_t *q = to_queue(head);
+    bool last = tail != q->reversed;
+    if (q->ring) {
+        int i;
+        for (i = 0; i < n && ring_grow(q); i++) {
+            element_t *new = new_element(q, s[i]);
+            if (!new)
+                break;
+            add_element(q, new, last);
+        }
+        return i;
     }
-    list_del(&temp->list);
 
+    element_t *next = NULL;
+    if (q->size)
+        next = end_element(q, last);
+
+    LIST_HEAD(chain);
+    int i;
+    for (i = 0; i < n; i++) {
+        element_t *new = new_element(q, s[i]);
+        if (!new)
+            break;
+        if (next)
+            sorted_add(q, next, new, tail);
+        next = new;
+        if (last)
+            list_add_tail(&new->list, &chain);
+        else
+            list_add(&new->list, &chain);
+    }
+    if (!i)
+        return 0;
+
+    /* Positions in the index follow the list */
+    struct q_index *ix = q->index;
+    if (ix && !ix->stale) {
+        size_t pos = last ? q->size + 1 : 1;
+        element_t *entry;
+        list_for_each_entry (entry, &chain, list) {
+            if (!index_insert(ix, pos++, entry)) {
+                ix->stale = true;
+                break;
+            }
+        }
+    }
+    if (last)
+        list_splice_tail(&chain, head);
+    else
+        list_splice(&chain, head);
+    q->size += i;
+    return i;
+}
+
+/* Insert n strings at head of queue */
+int q_insert_head_batch(struct list_head *head, char **s, int n)
+{
+    return insert_batch(head, s, n, false);
+}
+
+/* Insert n strings at tail of queue */
+int q_insert_tail_batch(struct list_head *head, char **s, int n)
+{
+    return insert_batch(head, s, n, true);
+}
+
+/* Insert an element into a sorted queue, after the ones equal to it */
+bool q_insert_sorted(struct list_head *head, char *s, bool descend)
+{
+    if (!head)
+        return false;
+    queue_t *q = to_queue(head);
+    ring_unpack(q);
+    element_t *new = new_element(q, s);
+    if (!new)
+        return false;
+
+    /* A reversed queue is sorted the other way round in memory, and the new
+     * element goes before the equal ones there
+     */
+    bool order = descend != q->reversed;
+    int ties = q->reversed ? 0 : 1;
+
+    if (index_sync(q)) {
+        struct q_index *ix = q->index;
+        struct skip_link *x = ix->head;
+        struct list_head *prev = head;
+        size_t at = 0;
+
+        for (int lvl = ix->level - 1; lvl >= 0; lvl--) {
+            while (x[lvl].next &&
+                   cmp_elements(x[lvl].next->e, new, order) < ties) {
+                at += x[lvl].width;
+                prev = &x[lvl].next->e->list;
+                x = x[lvl].next->link;
+            }
+        }
+        list_add(&new->list, prev);
+        q->size++;
+        sorted_reset(q, q->sorted & sorted_order(descend));
+        if (!index_insert(ix, at + 1, new))
+            ix->stale = true;
+        return true;
+    }
+
+    struct list_head *next;
+    list_for_each (next, head) {
+        if (cmp_elements(list_entry(next, element_t, list), new, order) >=
+            ties)
+            break;
+    }
+    list_add_tail(&new->list, next);
+    q->size++;
+    sorted_reset(q, q->sorted & sorted_order(descend));
+    index_stale(q);
+    return true;
+}
+
+/* Hand element temp, unlinked from queue q, over to the caller */
+static element_t *remove_element(queue_t *q,
+                                 element_t *temp,
+                                 char *sp,
+                                 size_t bufsize)
+{
+    if (sp && bufsize) {
+        size_t len = strnlen(temp->value, bufsize - 1);
+        memcpy(sp, temp->value, len);
+        sp[len] = '\0';
+    }
+
+    if (temp->value != temp->inline_value)
+        q->heap_values--;
+    q->size--;
+    if (q->size < 2)
+        q->sorted = SORTED_BOTH;
+    temp->slab->detached++;
     return temp;
 }
 
+/* Remove the first or the last node of queue q, regardless of its direction */
+static element_t *remove_first(queue_t *q, char *sp, size_t bufsize)
+{
+    element_t *e = end_element(q, false);
+    if (q->ring) {
+        q->ring_first = (q->ring_first + 1) & q->ring_mask;
+    } else {
+        if (q->index && !q->index->stale)
+            index_remove(q->index, 1);
+        list_del(&e->list);
+    }
+    return remove_element(q, e, sp, bufsize);
+}
+
+static element_t *remove_last(queue_t *q, char *sp, size_t bufsize)
+{
+    element_t *e = end_element(q, true);
+    if (!q->ring) {
+        if (q->index && !q->index->stale)
+            index_remove(q->index, q->size);
+        list_del(&e->list);
+    }
+    return remove_element(q, e, sp, bufsize);
+}
+
+/* Remove an element from head of queue */
+element_t *q_remove_head(struct list_head *head, char *sp, size_t bufsize)
+{
+    if (!head || !to_queue(head)->size)
+        return NULL;
+    queue_t *q = to_queue(head);
+    if (q->reversed)
+        return remove_last(q, sp, bufsize);
+    return remove_first(q, sp, bufsize);
+}
+
 /* Remove an element from tail of queue */
 element_t *q_remove_tail(struct list_head *head, char *sp, size_t bufsize)
 {
-    if (!head)
+    if (!head || !to_queue(head)->size)
         return NULL;
-    return q_remove_head(head->prev->prev, sp, bufsize);
+    queue_t *q = to_queue(head);
+    if (q->reversed)
+        return remove_first(q, sp, bufsize);
+    return remove_last(q, sp, bufsize);
+}
+
+/* Remove an element from head of queue, without copying its string */
+element_t *q_take_head(struct list_head *head)
+{
+    return q_remove_head(head, NULL, 0);
+}
+
+/* Remove an element from tail of queue, without copying its string */
+element_t *q_take_tail(struct list_head *head)
+{
+    return q_remove_tail(head, NULL, 0);
 }
 
 /* Return number of elements in queue */
@@ -114,62 +946,187 @@ int q_size(struct list_head *head)
     if (!head)
         return -1;
 
+#ifdef QUEUE_DEBUG
     int size = 0;
     struct list_head *this;
     list_for_each (this, head)
         ++size;
-    return size;
+    assert(to_queue(head)->ring || size == to_queue(head)->size);
+#endif
+    return to_queue(head)->size;
 }
 
 /* Delete the middle node in queue */
 bool q_delete_mid(struct list_head *head)
 {
     // https://leetcode.com/problems/delete-the-middle-node-of-a-linked-list/
-    if (!head)
+    if (!head || !to_queue(head)->size)
         return false;
 
+    /* With an even size, the middle node of a reversed queue is the one
+     * before the middle node in memory
+     */
+    queue_t *q = to_queue(head);
+    ring_unpack(q);
+    bool before = q->reversed && !(q->size & 1);
+    if (index_sync(q)) {
+        element_t *mid = index_remove(q->index, q->size / 2 + !before);
+        list_del_init(&mid->list);
+        delete_element(q, mid);
+        return true;
+    }
+
     struct list_head *slow, *fast;
     for (slow = head->next, fast = head->next;
          fast != head && fast->next != head;
          fast = fast->next->next, slow = slow->next)
         ;
+    if (before)
+        slow = slow->prev;
 
     list_del_init(slow);
-    q_release_element(list_entry(slow, element_t, list));
+    delete_element(q, list_entry(slow, element_t, list));
+    index_stale(q);
 
     return true;
 }
 
+/* Return the element at position k */
+element_t *q_at(struct list_head *head, int k)
+{
+    if (!head || k < 0 || k >= q_size(head))
+        return NULL;
+
+    queue_t *q = to_queue(head);
+    if (q->reversed)
+        k = q->size - 1 - k;
+    if (q->ring)
+        return *ring_slot(q, k);
+    if (index_sync(q))
+        return index_at(q->index, k + 1);
+
+    /* Walk from the nearer end */
+    struct list_head *node;
+    if (k < q->size / 2) {
+        for (node = head->next; k--; node = node->next)
+            ;
+    } else {
+        for (node = head->prev; ++k < q->size; node = node->prev)
+            ;
+    }
+    return list_entry(node, element_t, list);
+}
+
 /* Delete all nodes that have duplicate string */
 bool q_delete_dup(struct list_head *head)
 {
-    // https://leetcode.com/problems/remove-duplicates-from-sorted-list-ii/
+    // https://leetcode.com/problems/remove-duplicates-from-sorted-list-ii/
+    if (!head)
+        return false;
+
+    queue_t *q = to_queue(head);
+    ring_unpack(q);
+    index_stale(q);
+    element_t *entry, *safe;
+    bool duplicating = false;
+    list_for_each_entry_safe (entry, safe, head, list) {
+        if (&safe->list == head) {
+            break;
+        }
+
+        if (!element_cmp(entry, safe)) {
+            list_del(&entry->list);
+            delete_element(q, entry);
+            duplicating = true;
+        } else if (duplicating) {
+            list_del(&entry->list);
+            delete_element(q, entry);
+            duplicating = false;
+        }
+    }
+    if (duplicating) {
+        list_del(&entry->list);
+        delete_element(q, entry);
+    }
+
+
+    return true;
+}
+
+/* Slot of the hash set used by q_delete_dup_hash() */
+struct dup_slot {
+    element_t *first; /* First element with the string, NULL if free */
+    uint32_t check;   /* Upper bits of the hash, to skip most strcmp() */
+    bool dup;
+};
+
+/* Hash the string of an element, starting from its key */
+uint64_t element_hash(const element_t *e)
+{
+    uint64_t h = e->key;
+    if (e->key & 0xff) {
+        for (const char *s = e->value + 8; *s; s++)
+            h = (h ^ (unsigned char) *s) * 0x100000001b3ULL; /* FNV-1a */
+    }
+    return random_shuffle(h);
+}
+
+/* Delete all nodes that have duplicate string, keeping the order of the
+ * others, without sorting first
+ */
+bool q_delete_dup_hash(struct list_head *head)
+{
     if (!head)
         return false;
+    ring_unpack(to_queue(head));
+    index_stale(to_queue(head));
+
+    size_t n = q_size(head), cap = 2;
+    if (n < 2)
+        return true;
+
+    /* Keep the load factor at most 2/3 */
+    while (cap < n + n / 2)
+        cap <<= 1;
+    struct dup_slot *set = malloc(cap * sizeof(*set));
+    if (!set)
+        return false;
+    memset(set, 0, cap * sizeof(*set));
 
+    /* Later copies of a string are deleted as soon as they are seen, and
+     * the slot of the first one is marked
+     */
+    queue_t *q = to_queue(head);
     element_t *entry, *safe;
-    bool duplicating = false;
     list_for_each_entry_safe (entry, safe, head, list) {
-        if (&safe->list == head) {
-            break;
-        }
+        uint64_t h = element_hash(entry);
+        uint32_t check = h >> 32;
+        size_t i = h & (cap - 1);
 
-        if (!strcmp(entry->value, safe->value)) {
-            list_del(&entry->list);
-            q_release_element(entry);
-            duplicating = true;
-        } else if (duplicating) {
-            list_del(&entry->list);
-            q_release_element(entry);
-            duplicating = false;
+        for (;; i = (i + 1) & (cap - 1)) {
+            struct dup_slot *slot = &set[i];
+            if (!slot->first) {
+                slot->first = entry;
+                slot->check = check;
+                break;
+            }
+            if (slot->check == check && !element_cmp(slot->first, entry)) {
+                slot->dup = true;
+                list_del(&entry->list);
+                delete_element(q, entry);
+                break;
+            }
         }
     }
-    if (duplicating) {
-        list_del(&entry->list);
-        q_release_element(entry);
-    }
-
 
+    /* Then the first copies of the marked strings */
+    for (size_t i = 0; i < cap; i++) {
+        if (set[i].dup) {
+            list_del(&set[i].first->list);
+            delete_element(q, set[i].first);
+        }
+    }
+    free(set);
     return true;
 }
 
@@ -180,6 +1137,10 @@ void q_swap(struct list_head *head)
     if (!head)
         return;
 
+    q_materialize(head);
+    index_stale(to_queue(head));
+    sorted_reset(to_queue(head), 0);
+
     struct list_head *this, *temp;
     for (this = head, temp = head;
          temp->next != head && temp->next->next != head;
@@ -189,15 +1150,62 @@ void q_swap(struct list_head *head)
     }
 }
 
+/* Reverse the nodes of a list, which does not have to be a queue */
+static void reverse_list(struct list_head *head)
+{
+    struct list_head **sec_last = &head->prev->prev;
+    while (*sec_last != head) {
+        list_move_tail(*sec_last, head);
+    }
+}
+
 /* Reverse elements in queue */
 void q_reverse(struct list_head *head)
 {
     if (!head)
         return;
-    struct list_head **sec_last = &head->prev->prev;
-    while (*sec_last != head) {
-        list_move_tail(*sec_last, head);
+    queue_t *q = to_queue(head);
+    q->sorted = (q->sorted & SORTED_ASC) << 1 | (q->sorted & SORTED_DESC) >> 1;
+    if (lazy_reverse || q->reversed || q->ring) {
+        q->reversed = !q->reversed;
+        return;
     }
+    index_stale(q);
+    reverse_list(head);
+}
+
+/* Lay out the elements of a ring queue or of a lazily reversed queue in its
+ * list, from head to tail
+ */
+void q_materialize(struct list_head *head)
+{
+    if (!head)
+        return;
+    queue_t *q = to_queue(head);
+    ring_unpack(q);
+    if (!q->reversed)
+        return;
+    q->reversed = false;
+    index_stale(q);
+    reverse_list(head);
+}
+
+/* Return whether queue is known to be in ascending/descending order */
+bool q_is_sorted(struct list_head *head, bool descend)
+{
+    return head && to_queue(head)->sorted & sorted_order(descend);
+}
+
+/* Return whether the elements of queue are laid out from tail to head */
+bool q_is_reversed(struct list_head *head)
+{
+    return head && to_queue(head)->reversed;
+}
+
+/* Return whether the elements of queue are kept in an array */
+bool q_is_ring(struct list_head *head)
+{
+    return head && to_queue(head)->ring;
 }
 
 /* Reverse the nodes of the list k at a time */
@@ -207,6 +1215,10 @@ void q_reverseK(struct list_head *head, int k)
     if (!head || k <= 1)
         return;
 
+    q_materialize(head);
+    index_stale(to_queue(head));
+    sorted_reset(to_queue(head), 0);
+
     int size = q_size(head);
     struct list_head *this = head->next;
     while (size >= k) {
@@ -217,7 +1229,7 @@ void q_reverseK(struct list_head *head, int k)
         LIST_HEAD(temp);
 
         list_cut_position(&temp, head, this->prev);
-        q_reverse(&temp);
+        reverse_list(&temp);
         list_splice_tail_init(&temp, head);
 
         size -= k;
@@ -233,43 +1245,447 @@ void q_reverseK(struct list_head *head, int k)
     }
 }
 
-/* Merge two sorted list */
+/* Return the last node of the longest stretch from first, which itself
+ * belongs to it, up to end, of elements placed before pivot. With ties, equal
+ * elements are placed before pivot too.
+ *
+ * Like gallop() in list_sort.c, this is an exponential search followed by a
+ * binary search, making O(log k) comparisons for a stretch of k nodes.
+ */
+static struct list_head *gallop_before(struct list_head *first,
+                                       struct list_head *end,
+                                       const element_t *pivot,
+                                       bool ties,
+                                       bool descend)
+{
+    struct list_head *lo = first;
+    size_t step = 1;
+
+    for (;;) {
+        struct list_head *probe = lo;
+        size_t dist = 0;
+
+        while (dist < step && probe->next != end) {
+            probe = probe->next;
+            dist++;
+        }
+        if (!dist)
+            return lo;
+
+        int r = cmp_elements(list_entry(probe, element_t, list), pivot,
+                             descend);
+        if (r < 0 || (ties && !r)) {
+            lo = probe;
+            if (dist < step)
+                return lo;
+            step <<= 1;
+            continue;
+        }
+
+        /* The stretch ends after lo and before probe */
+        while (dist > 1) {
+            size_t half = dist / 2;
+            struct list_head *mid = lo;
+
+            for (size_t i = 0; i < half; i++)
+                mid = mid->next;
+            r = cmp_elements(list_entry(mid, element_t, list), pivot, descend);
+            if (r < 0 || (ties && !r)) {
+                lo = mid;
+                dist -= half;
+            } else {
+                dist = half;
+            }
+        }
+        return lo;
+    }
+}
+
+/* Merge two sorted list, the elements of head_cut go after equal ones of
+ * head. Once one list has won merge_gallop times in a row, the rest of its
+ * winning stretch is found by gallop_before() and moved at once.
+ */
 void merge_two_sorted(struct list_head *head_cut,
                       struct list_head *head,
                       bool descend)
 {
     struct list_head *this = head->next;
+    unsigned int wins_head = 0, wins_cut = 0;
     while (!list_empty(head_cut) && this != head) {
         element_t *entry1 = list_first_entry(head_cut, element_t, list);
         element_t *entry2 = list_entry(this, element_t, list);
-        if (strcmp(entry1->value, entry2->value) * (descend ? -1 : 1) > 0) {
+        if (cmp_elements(entry1, entry2, descend) >= 0) {
+            wins_cut = 0;
+            if (merge_gallop > 0 && ++wins_head >= merge_gallop) {
+                this = gallop_before(this, head, entry1, true, descend);
+                wins_head = 0;
+            }
             this = this->next;
-        } else
+        } else if (merge_gallop > 0 && ++wins_cut >= merge_gallop) {
+            struct list_head *last =
+                gallop_before(&entry1->list, head_cut, entry2, false, descend);
+            LIST_HEAD(stretch);
+
+            list_cut_position(&stretch, head_cut, last);
+            list_splice_tail(&stretch, this);
+            wins_head = wins_cut = 0;
+        } else {
+            wins_head = 0;
             list_move_tail(&entry1->list, this);
+        }
     }
     list_splice_tail_init(head_cut, head);
 };
 
 
+/* Return > 0 if the element of a should be placed after the one of b */
+static inline int cmp_order(const struct list_head *a,
+                            const struct list_head *b,
+                            bool descend)
+{
+    int r = element_cmp(list_entry(a, element_t, list),
+                        list_entry(b, element_t, list));
+    return descend ? -r : r;
+}
+
+/* Merge two null-terminated sorted lists. Like merge() in list_sort.c, the
+ * prev links are not maintained, and a is taken first on ties to keep the
+ * sort stable.
+ */
+static struct list_head *merge_sorted(struct list_head *a,
+                                      struct list_head *b,
+                                      bool descend)
+{
+    struct list_head *head = NULL, **tail = &head;
+
+    for (;;) {
+        if (cmp_order(a, b, descend) <= 0) {
+            *tail = a;
+            tail = &a->next;
+            a = a->next;
+            if (!a) {
+                *tail = b;
+                break;
+            }
+        } else {
+            *tail = b;
+            tail = &b->next;
+            b = b->next;
+            if (!b) {
+                *tail = a;
+                break;
+            }
+        }
+    }
+    return head;
+}
+
+/* Last merge of q_sort(), which also restores the prev links and makes the
+ * result circular again.
+ */
+static void merge_sorted_final(struct list_head *head,
+                               struct list_head *a,
+                               struct list_head *b,
+                               bool descend)
+{
+    struct list_head *tail = head;
+
+    for (;;) {
+        if (cmp_order(a, b, descend) <= 0) {
+            tail->next = a;
+            a->prev = tail;
+            tail = a;
+            a = a->next;
+            if (!a)
+                break;
+        } else {
+            tail->next = b;
+            b->prev = tail;
+            tail = b;
+            b = b->next;
+            if (!b) {
+                b = a;
+                break;
+            }
+        }
+    }
+
+    tail->next = b;
+    do {
+        b->prev = tail;
+        tail = b;
+        b = b->next;
+    } while (b);
+
+    tail->next = head;
+    head->prev = tail;
+}
+
+/* Comparison callback for list_sort_adaptive(), priv points to descend */
+static int cmp_sort(void *priv,
+                    const struct list_head *a,
+                    const struct list_head *b)
+{
+    return cmp_order(a, b, *(bool *) priv);
+}
+
+/* Sort a null-terminated list of at least two elements, up to the last
+ * merge, which is left to the caller with the sorted sublists *a and *b.
+ *
+ * This is a bottom-up merge sort using the same pending list scheme as
+ * list_sort(): each element is pushed as a sorted sublist of size 1, and two
+ * pending sublists of size 2^k are merged as soon as 2^k elements follow
+ * them. No midpoint has to be searched for and no recursion is needed.
+ */
+static void sort_pending(struct list_head *list,
+                         bool descend,
+                         struct list_head **a,
+                         struct list_head **b)
+{
+    struct list_head *pending = NULL;
+    size_t count = 0; /* Count of pending */
+
+    do {
+        size_t bits;
+        struct list_head **tail = &pending;
+
+        /* Find the least-significant clear bit in count */
+        for (bits = count; bits & 1; bits >>= 1)
+            tail = &(*tail)->prev;
+        /* Merge the two sublists of size 2^k it indicates */
+        if (bits) {
+            struct list_head *a = *tail, *b = a->prev;
+
+            a = merge_sorted(b, a, descend);
+            a->prev = b->prev;
+            *tail = a;
+        }
+
+        /* Move one element from input list to pending */
+        list->prev = pending;
+        pending = list;
+        list = list->next;
+        pending->next = NULL;
+        count++;
+    } while (list);
+
+    /* Merge all pending lists, from the smallest to the largest */
+    list = pending;
+    pending = pending->prev;
+    for (;;) {
+        struct list_head *next = pending->prev;
+
+        if (!next)
+            break;
+        list = merge_sorted(pending, list, descend);
+        pending = next;
+    }
+    *a = pending;
+    *b = list;
+}
+
+/* Queues shorter than this many elements per thread are sorted serially */
+#define PARALLEL_SORT_MIN 4096
+
+/* A segment of the queue sorted by a thread, or two of them merged. For
+ * q_merge(), a and b are queues and b is merged into a.
+ */
+struct sort_task {
+    struct list_head *a, *b;
+    bool descend;
+    struct wp_task wp;
+    void *(*worker)(void *);
+};
+
+static void *sort_worker(void *arg)
+{
+    struct sort_task *task = arg;
+
+    if (!task->b) {
+        struct list_head *a, *b;
+        sort_pending(task->a, task->descend, &a, &b);
+        task->a = merge_sorted(a, b, task->descend);
+    } else {
+        task->a = merge_sorted(task->a, task->b, task->descend);
+    }
+    return NULL;
+}
+
+static void *merge_worker(void *arg)
+{
+    struct sort_task *task = arg;
+
+    merge_two_sorted(task->b, task->a, task->descend);
+    return NULL;
+}
+
+/* Work-stealing pool of sort_threads threads, kept between calls */
+static struct workpool *sort_pool;
+static int sort_pool_threads;
+
+static struct workpool *get_sort_pool(void)
+{
+    int threads = sort_threads;
+    if (threads > MAX_SORT_THREADS)
+        threads = MAX_SORT_THREADS;
+
+    if (sort_pool && sort_pool_threads != threads) {
+        workpool_free(sort_pool);
+        sort_pool = NULL;
+    }
+    if (!sort_pool) {
+        sort_pool = workpool_new(threads);
+        sort_pool_threads = threads;
+    }
+    return sort_pool;
+}
+
+void q_pool_free(void)
+{
+    workpool_free(sort_pool);
+    sort_pool = NULL;
+}
+
+static void sort_task_run(struct wp_task *wp)
+{
+    struct sort_task *task = container_of(wp, struct sort_task, wp);
+    task->worker(task);
+}
+
+/* Root task of run_tasks() */
+struct sort_batch {
+    struct wp_task wp;
+    struct sort_task *tasks;
+    int n;
+};
+
+static void sort_batch_run(struct wp_task *wp)
+{
+    struct sort_batch *batch = container_of(wp, struct sort_batch, wp);
+
+    for (int i = 1; i < batch->n; i++)
+        wp_spawn(wp, &batch->tasks[i].wp);
+    sort_task_run(&batch->tasks[0].wp);
+    wp_wait(wp);
+}
+
+/* Run tasks[0..n-1] on the work-stealing pool, the calling thread taking
+ * part, and wait for all of them. If the pool cannot be created, the tasks
+ * are run one after the other in the calling thread.
+ */
+static void run_tasks(struct sort_task *tasks,
+                      int n,
+                      void *(*worker)(void *))
+{
+    struct workpool *pool = n > 1 ? get_sort_pool() : NULL;
+
+    if (!pool) {
+        for (int i = 0; i < n; i++)
+            worker(&tasks[i]);
+        return;
+    }
+
+    struct sort_batch batch = {.tasks = tasks, .n = n};
+    wp_task_init(&batch.wp, sort_batch_run);
+    for (int i = 0; i < n; i++) {
+        tasks[i].worker = worker;
+        wp_task_init(&tasks[i].wp, sort_task_run);
+    }
+    workpool_run(pool, &batch.wp);
+}
+
+/* Split the null-terminated list of n elements into segments, sort them in
+ * parallel, then merge them pairwise in parallel rounds. The last merge
+ * restores the queue around head.
+ *
+ * SIGALRM is blocked until the queue is whole again. The time limit alarm
+ * of qtest jumps out of the signal handler, which must not happen while
+ * other threads are still working on the queue, so it is delivered after
+ * the sort instead.
+ */
+static void parallel_sort(struct list_head *head,
+                          struct list_head *list,
+                          size_t n,
+                          int segments,
+                          bool descend)
+{
+    struct sort_task tasks[MAX_SORT_THREADS];
+    sigset_t mask, old;
+
+    sigemptyset(&mask);
+
+    sigaddset(&mask, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &mask, &old);
+    for (int i = 0; i < segments; i++) {
+        size_t len = n / segments + (i < n % segments);
+        tasks[i] = (struct sort_task){.a = list, .b = NULL, .descend = descend};
+        while (--len)
+            list = list->next;
+        struct list_head *next = list->next;
+        list->next = NULL;
+        list = next;
+    }
+    run_tasks(tasks, segments, sort_worker);
+
+    /* Merge neighbouring segments until two are left, keeping the order of
+     * segments so that the sort stays stable.
+     */
+    while (segments > 2) {
+        int pairs = segments / 2;
+        for (int i = 0; i < pairs; i++) {
+            tasks[i].a = tasks[2 * i].a;
+            tasks[i].b = tasks[2 * i + 1].a;
+        }
+        run_tasks(tasks, pairs, sort_worker);
+        if (segments & 1)
+            tasks[pairs++].a = tasks[segments - 1].a;
+        segments = pairs;
+    }
+    merge_sorted_final(head, tasks[0].a, tasks[1].a, descend);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
 /* Sort elements of queue in ascending/descending order */
 void q_sort(struct list_head *head, bool descend)
 {
-    if (!head || list_empty(head) || list_is_singular(head))
+    if (!head)
+        return;
+    queue_t *q = to_queue(head);
+    if (q->sorted & sorted_order(descend)) {
+        q_stats.sorts_skipped++;
+        return;
+    }
+    ring_unpack(q);
+    q_stats.sorts++;
+    q->sorted = sorted_order(descend);
+    /* Sorting decides the order anyway */
+    q->reversed = false;
+    index_stale(q);
+    if (list_empty(head) || list_is_singular(head))
         return;
 
+    if (sort_adaptive) {
+        list_sort_adaptive(&descend, head, cmp_sort);
+        return;
+    }
 
-    struct list_head *slow, *fast;
-    for (slow = head, fast = head;
-         fast->next != head && fast->next->next != head;
-         fast = fast->next->next, slow = slow->next)
-        ;
+    struct list_head *list = head->next, *a, *b;
+    size_t n = q_size(head);
+    int segments = sort_threads;
+    if (segments > MAX_SORT_THREADS)
+        segments = MAX_SORT_THREADS;
+    if (segments > 1 && n / segments < PARALLEL_SORT_MIN)
+        segments = n / PARALLEL_SORT_MIN;
 
-    LIST_HEAD(temp);
-    list_cut_position(&temp, head, slow);
-    q_sort(&temp, descend);
-    q_sort(head, descend);
+    /* Convert to a null-terminated singly-linked list */
+    head->prev->next = NULL;
 
-    merge_two_sorted(&temp, head, descend);
+    if (segments > 1) {
+        parallel_sort(head, list, n, segments, descend);
+        return;
+    }
+    sort_pending(list, descend, &a, &b);
+    merge_sorted_final(head, a, b, descend);
 }
 
 /* Remove every node which has a node with a strictly less value anywhere to
@@ -279,17 +1695,20 @@ int q_ascend(struct list_head *head)
     // https://leetcode.com/problems/remove-nodes-from-linked-list/
     if (!head)
         return 0;
+    q_materialize(head);
+    index_stale(to_queue(head));
+    sorted_reset(to_queue(head), SORTED_ASC);
 
     struct list_head *this = head->next;
 
     while (this->next != head) {
         element_t *entry1 = list_entry(this, element_t, list);
         element_t *entry2 = list_entry(this->next, element_t, list);
-        if (strcmp(entry1->value, entry2->value) < 0) {
+        if (element_cmp(entry1, entry2) < 0) {
             this = this->next;
         } else {
             list_del(&entry2->list);
-            q_release_element(entry2);
+            delete_element(to_queue(head), entry2);
         }
     }
 
@@ -303,71 +1722,359 @@ int q_descend(struct list_head *head)
     // https://leetcode.com/problems/remove-nodes-from-linked-list/
     if (!head)
         return 0;
+    q_materialize(head);
+    index_stale(to_queue(head));
+    sorted_reset(to_queue(head), SORTED_DESC);
 
     struct list_head *this = head->prev;
 
     while (this->prev != head) {
         element_t *entry1 = list_entry(this, element_t, list);
         element_t *entry2 = list_entry(this->prev, element_t, list);
-        if (strcmp(entry1->value, entry2->value) < 0) {
+        if (element_cmp(entry1, entry2) < 0) {
             this = this->prev;
         } else {
             list_del(&entry2->list);
-            q_release_element(entry2);
+            delete_element(to_queue(head), entry2);
         }
     }
 
     return q_size(head);
 }
 
+/* Update queue a, into which queue b has been merged. The result is only
+ * known to be sorted if both queues were.
+ */
+static void merge_finish(struct list_head *a, struct list_head *b, bool descend)
+{
+    int sorted = to_queue(a)->sorted & to_queue(b)->sorted;
+
+    queue_adopt(to_queue(a), to_queue(b));
+    index_stale(to_queue(a));
+    index_stale(to_queue(b));
+    sorted_reset(to_queue(a), sorted & sorted_order(descend));
+    sorted_reset(to_queue(b), 0);
+}
+
+/* Merge the queues of each task in parallel, then hand the slabs over */
+static void merge_queues(struct sort_task *tasks, int n)
+{
+    if (!n)
+        return;
+    run_tasks(tasks, n, merge_worker);
+    q_stats.merges += n;
+    for (int i = 0; i < n; i++)
+        merge_finish(tasks[i].a, tasks[i].b, tasks[i].descend);
+}
+
+/* Move the elements of sorted queue b into sorted queue a in O(1) time if
+ * all of them go before or after the ones of a. Return false if they have
+ * to be merged.
+ */
+static bool merge_concat(struct list_head *a, struct list_head *b, bool descend)
+{
+    if (list_empty(a) || list_empty(b) ||
+        cmp_elements(list_last_entry(a, element_t, list),
+                     list_first_entry(b, element_t, list), descend) <= 0) {
+        list_splice_tail_init(b, a);
+        return true;
+    }
+    if (cmp_elements(list_last_entry(b, element_t, list),
+                     list_first_entry(a, element_t, list), descend) < 0) {
+        list_splice_init(b, a);
+        return true;
+    }
+    return false;
+}
+
+/* Return the queue n places after ctx in the chain */
+static queue_contex_t *chain_advance(queue_contex_t *ctx, int n)
+{
+    while (n--)
+        ctx = list_entry(ctx->chain.next, queue_contex_t, chain);
+    return ctx;
+}
+
 /* Merge all the queues into one sorted queue, which is in ascending/descending
  * order */
 int q_merge(struct list_head *head, bool descend)
 {
     // https://leetcode.com/problems/merge-k-sorted-lists/
-    if (!head)
+    if (!head || list_empty(head))
         return 0;
 
-    if (q_size(head) < 2)
-        return q_size(head);
-
     struct list_head *this = list_first_entry(head, queue_contex_t, chain)->q;
-    queue_contex_t *entry, *safe;
-    bool first_time = true;
-    list_for_each_entry_safe (entry, safe, head, chain) {
-        if (first_time) {
-            first_time = false;
-            continue;
+    if (list_is_singular(head)) {
+        ring_unpack(to_queue(this));
+        return q_size(this);
+    }
+
+    int k = 0;
+    queue_contex_t *ctx;
+    list_for_each_entry (ctx, head, chain) {
+        q_materialize(ctx->q);
+        k++;
+    }
+
+    int threads = sort_threads;
+    if (threads > MAX_SORT_THREADS)
+        threads = MAX_SORT_THREADS;
+    else if (threads < 1)
+        threads = 1;
+
+    /* Block SIGALRM while other threads work on the queues, see
+     * parallel_sort()
+     */
+    sigset_t mask, old;
+    if (threads > 1) {
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGALRM);
+        pthread_sigmask(SIG_BLOCK, &mask, &old);
+    }
+
+    /* Merge neighbouring queues in rounds, as a bottom-up merge sort would,
+     * so every element is moved O(log k) times. Merging all queues into the
+     * first one in turn walks its growing list k times instead. The pairs of
+     * a round are independent and are merged by up to sort_threads threads.
+     */
+    struct sort_task tasks[MAX_SORT_THREADS];
+    for (int step = 1; step < k; step *= 2) {
+        queue_contex_t *entry = list_first_entry(head, queue_contex_t, chain);
+        int n = 0;
+        for (int i = 0; i + step < k; i += 2 * step) {
+            queue_contex_t *other = chain_advance(entry, step);
+            if (merge_concat(entry->q, other->q, descend)) {
+                q_stats.merges_skipped++;
+                merge_finish(entry->q, other->q, descend);
+            } else {
+                tasks[n++] = (struct sort_task){
+                    .a = entry->q, .b = other->q, .descend = descend};
+            }
+            if (n == threads) {
+                merge_queues(tasks, n);
+                n = 0;
+            }
+            if (i + 2 * step < k)
+                entry = chain_advance(other, step);
         }
-        merge_two_sorted(entry->q, this, descend);
+        merge_queues(tasks, n);
     }
 
+    if (threads > 1)
+        pthread_sigmask(SIG_SETMASK, &old, NULL);
     return q_size(this);
 }
 
-static inline void swap(struct list_head *a, struct list_head *b)
+/* State of a splitmix64 generator, whose output function is
+ * random_shuffle(). It is seeded from rand() by every q_shuffle(), so that
+ * shuffles follow srand() like the rest of the harness does.
+ */
+static uint64_t shuffle_state;
+
+static void shuffle_seed(void)
+{
+    shuffle_state = (uint64_t) rand() << 32 ^ (uint64_t) rand();
+}
+
+static uint64_t shuffle_rand(void)
+{
+    shuffle_state += 0x9e3779b97f4a7c15ULL;
+    return random_shuffle(shuffle_state);
+}
+
+/* Uniform random number in [0, n), rejecting the few draws that would bias
+ * the remainder
+ */
+static size_t shuffle_below(size_t n)
+{
+    uint64_t limit = UINT64_MAX - UINT64_MAX % n, x;
+
+    do
+        x = shuffle_rand();
+    while (x >= limit);
+    return x % n;
+}
+
+/* Fisher-Yates shuffle of an array of n nodes */
+static void shuffle_nodes(struct list_head **nodes, size_t n)
+{
+    for (size_t i = n - 1; i > 0; i--) {
+        size_t j = shuffle_below(i + 1);
+        struct list_head *tmp = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = tmp;
+    }
+}
+
+/* Link the nodes of the array in order between prev and next */
+static void relink_nodes(struct list_head *prev,
+                         struct list_head **nodes,
+                         size_t n,
+                         struct list_head *next)
+{
+    for (size_t i = 0; i < n; i++) {
+        prev->next = nodes[i];
+        nodes[i]->prev = prev;
+        prev = nodes[i];
+    }
+    prev->next = next;
+    next->prev = prev;
+}
+
+/* Shuffle through an array of all nodes. Return false if it could not be
+ * allocated.
+ */
+static bool shuffle_array(struct list_head *head, size_t n)
+{
+    struct list_head **nodes = malloc(n * sizeof(*nodes));
+    if (!nodes)
+        return false;
+
+    struct list_head *node;
+    size_t i = 0;
+    list_for_each (node, head)
+        nodes[i++] = node;
+    shuffle_nodes(nodes, n);
+    relink_nodes(head, nodes, n, head);
+    free(nodes);
+    return true;
+}
+
+/* Nodes shuffled at once on the stack by shuffle_blockwise() */
+#define SHUFFLE_BLOCK 1024
+
+/* Runs interleaved at once by shuffle_blockwise() */
+#define RIFFLE_WAYS 1024
+
+/* Cut the null-terminated list after at most n nodes. Return the last node
+ * kept and store the number of them in *len.
+ */
+static struct list_head *cut_after(struct list_head *list,
+                                   size_t n,
+                                   size_t *len)
+{
+    *len = 1;
+    while (*len < n && list->next) {
+        list = list->next;
+        (*len)++;
+    }
+    return list;
+}
+
+/* Interleave k null-terminated lists, taking the next node from each with
+ * probability proportional to the number of nodes it has left, so that
+ * every interleaving is equally likely. The counts are kept in a Fenwick
+ * tree for the draws. Return the first node, and the last one in *last.
+ */
+static struct list_head *riffle(struct list_head **lists,
+                                struct list_head **lasts,
+                                size_t *lens,
+                                int k,
+                                struct list_head **last)
+{
+    size_t tree[RIFFLE_WAYS + 1] = {0}, left = 0;
+    int top = 1;
+
+    while (top * 2 <= k)
+        top *= 2;
+    for (int i = 1; i <= k; i++) {
+        tree[i] += lens[i - 1];
+        if (i + (i & -i) <= k)
+            tree[i + (i & -i)] += tree[i];
+        left += lens[i - 1];
+    }
+
+    struct list_head *first = NULL, **tail = &first;
+    int i = 0;
+    for (; left; left--) {
+        size_t r = shuffle_below(left);
+
+        i = 0;
+        for (int step = top; step; step >>= 1) {
+            if (i + step <= k && tree[i + step] <= r) {
+                i += step;
+                r -= tree[i];
+            }
+        }
+        *tail = lists[i];
+        tail = &lists[i]->next;
+        lists[i] = lists[i]->next;
+        for (int j = i + 1; j <= k; j += j & -j)
+            tree[j]--;
+    }
+    *last = lasts[i];
+    return first;
+}
+
+/* Shuffle without allocating. Blocks of SHUFFLE_BLOCK nodes are shuffled
+ * through an array on the stack, then up to RIFFLE_WAYS neighbouring
+ * shuffled runs at a time are riffled together. Each riffle picks a
+ * uniformly random interleaving, so the result is uniform too. This takes
+ * O(n log(n / SHUFFLE_BLOCK)) time, in few passes over the list.
+ */
+static void shuffle_blockwise(struct list_head *head, size_t n)
 {
-    element_t *a_entry = list_entry(a, element_t, list);
-    element_t *b_entry = list_entry(b, element_t, list);
-    char *tmp = b_entry->value;
-    b_entry->value = a_entry->value;
-    a_entry->value = tmp;
+    struct list_head *nodes[SHUFFLE_BLOCK];
+    struct list_head *prev = head, *node = head->next;
+
+    while (node != head) {
+        size_t len = 0;
+        for (; len < SHUFFLE_BLOCK && node != head; node = node->next)
+            nodes[len++] = node;
+        shuffle_nodes(nodes, len);
+        relink_nodes(prev, nodes, len, node);
+        prev = nodes[len - 1];
+    }
+
+    /* Convert to a null-terminated singly-linked list */
+    struct list_head *list = head->next;
+    head->prev->next = NULL;
+
+    struct list_head *lists[RIFFLE_WAYS], *lasts[RIFFLE_WAYS];
+    size_t lens[RIFFLE_WAYS];
+    for (size_t width = SHUFFLE_BLOCK; width < n; width *= RIFFLE_WAYS) {
+        struct list_head *rest = list, **tail = &list;
+
+        while (rest) {
+            int k = 0;
+            for (; k < RIFFLE_WAYS && rest; k++) {
+                lists[k] = rest;
+                lasts[k] = cut_after(rest, width, &lens[k]);
+                rest = lasts[k]->next;
+                lasts[k]->next = NULL;
+            }
+            struct list_head *last;
+            *tail = riffle(lists, lasts, lens, k, &last);
+            tail = &last->next;
+        }
+    }
+
+    /* Restore the prev links */
+    prev = head;
+    for (node = list; node; node = node->next) {
+        prev->next = node;
+        node->prev = prev;
+        prev = node;
+    }
+    prev->next = head;
+    head->prev = prev;
 }
 
 /* Shuffle elements of queue */
 void q_shuffle(struct list_head *head)
 {
-    if (!head || list_is_singular(head))
+    if (!head)
         return;
+    ring_unpack(to_queue(head));
+    /* Any order is as likely as its reverse */
+    to_queue(head)->reversed = false;
+    if (list_empty(head) || list_is_singular(head))
+        return;
+    index_stale(to_queue(head));
+    sorted_reset(to_queue(head), 0);
 
-    int len = q_size(head) - 1;
-    struct list_head *new;
-
-    for (new = head->prev; new != head &&len; new = new->prev, len--) {
-        int r = rand() % len;
-        struct list_head *old = head->next;
-        while (r--)
-            old = old->next;
-        swap(old, new);
-    }
+    size_t n = q_size(head);
+    shuffle_seed();
+    if (shuffle_noalloc || !shuffle_array(head, n))
+        shuffle_blockwise(head, n);
 }
@@ -9,20 +9,38 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "harness.h"
 #include "list.h"
 
+/* Strings up to ELEMENT_INLINE_SIZE bytes, including the terminating null
+ * byte, are stored in the element itself instead of a separate allocation.
+ */
+#define ELEMENT_INLINE_SIZE 32
+
+struct q_slab;
+
 /**
  * element_t - Linked list element
+ * @key: the first 8 bytes of @value, zero padded, in big-endian order, so
+ *       that comparing two keys as integers agrees with strcmp() unless both
+ *       strings share these bytes
  * @value: pointer to array holding string
  * @list: node of a doubly-linked list
+ * @slab: the slab of the queue this element was allocated from
+ * @inline_value: storage for short strings, allocated along with the element
  *
- * @value needs to be explicitly allocated and freed
+ * @value either points to @inline_value or to an array which needs to be
+ * explicitly allocated and freed.
  */
 typedef struct {
+    uint64_t key;
     char *value;
     struct list_head list;
+    struct q_slab *slab;
+    char inline_value[];
 } element_t;
 
 /**
@@ -39,11 +57,90 @@ typedef struct {
     int id;
 } queue_contex_t;
 
+/**
+ * element_key() - Compute the key of an element from its string
+ * @s: string of the element
+ */
+static inline uint64_t element_key(const char *s)
+{
+    uint64_t key = 0;
+    for (int i = 0; i < 8; i++) {
+        key <<= 8;
+        if (*s)
+            key |= (unsigned char) *s++;
+    }
+    return key;
+}
+
+/**
+ * element_cmp() - Compare the strings of two elements
+ * @a: first element
+ * @b: second element
+ *
+ * The keys decide unless they are equal, in which case the strings are equal
+ * if they end within the key, or are compared from their ninth byte on.
+ *
+ * Return: less than, equal to, or greater than zero, as strcmp() would
+ */
+static inline int element_cmp(const element_t *a, const element_t *b)
+{
+    if (a->key != b->key)
+        return a->key < b->key ? -1 : 1;
+    if (!(a->key & 0xff))
+        return 0;
+    return strcmp(a->value + 8, b->value + 8);
+}
+
+/**
+ * element_hash() - Hash the string of an element
+ * @e: the element
+ *
+ * The key is taken as is, and the rest of the string is mixed into it with
+ * FNV-1a, then all the bits are mixed once more. Equal strings have equal
+ * hashes.
+ */
+uint64_t element_hash(const element_t *e);
+
+/* Tunables, exposed as options by qtest */
+
+/* Sort with natural run detection instead of a plain merge sort */
+extern int sort_adaptive;
+
+/* Number of threads used by q_sort() and q_merge(), at most MAX_SORT_THREADS
+ */
+#define MAX_SORT_THREADS 64
+extern int sort_threads;
+
+/* Stop the threads which q_sort() and q_merge() keep between calls. They
+ * are started again when needed.
+ */
+void q_pool_free(void);
+
+/* Make q_reverse() flip the direction of the queue instead of moving nodes */
+extern int lazy_reverse;
+
+/* Make q_new() create ring queues, see q_is_ring() */
+extern int ring_queues;
+
+/* Make q_shuffle() use its block-wise shuffle, which does not allocate */
+extern int shuffle_noalloc;
+
+/* Work done and avoided by q_sort() and q_merge(), reported by qtest */
+struct q_stats {
+    unsigned long sorts;          /* queues sorted by q_sort() */
+    unsigned long sorts_skipped;  /* calls to q_sort() on a sorted queue */
+    unsigned long merges;         /* pairs of queues merged element-wise */
+    unsigned long merges_skipped; /* pairs of queues merely concatenated */
+};
+extern struct q_stats q_stats;
+
 /* Operations on queue */
 
 /**
  * q_new() - Create an empty queue whose next and prev pointer point to itself
  *
+ * If ring_queues is set, the queue is a ring queue, see q_is_ring().
+ *
  * Return: NULL for allocation failed
  */
 struct list_head *q_new();
@@ -78,6 +175,48 @@ bool q_insert_head(struct list_head *head, char *s);
  */
 bool q_insert_tail(struct list_head *head, char *s);
 
+/**
+ * q_insert_head_batch() - Insert elements in the head
+ * @head: header of queue
+ * @s: array of strings would be inserted
+ * @n: number of strings in @s
+ *
+ * Same as calling q_insert_head() for s[0] to s[n - 1] in turn, so s[n - 1]
+ * ends up at the head, but the new elements are linked to each other first
+ * and spliced into the queue at once. Insertion stops at the first string
+ * which cannot be allocated.
+ *
+ * Return: number of strings inserted, 0 if queue is NULL
+ */
+int q_insert_head_batch(struct list_head *head, char **s, int n);
+
+/**
+ * q_insert_tail_batch() - Insert elements at the tail
+ * @head: header of queue
+ * @s: array of strings would be inserted
+ * @n: number of strings in @s
+ *
+ * Same as calling q_insert_tail() for s[0] to s[n - 1] in turn, see
+ * q_insert_head_batch().
+ *
+ * Return: number of strings inserted, 0 if queue is NULL
+ */
+int q_insert_tail_batch(struct list_head *head, char **s, int n);
+
+/**
+ * q_insert_sorted() - Insert an element into a sorted queue
+ * @head: header of queue
+ * @s: string would be inserted
+ * @descend: whether or not the queue is sorted in descending order
+ *
+ * The element goes after the ones with an equal string. If the queue is
+ * indexed, see q_index(), the place is found in O(log n) time, otherwise the
+ * list is walked from the head.
+ *
+ * Return: true for success, false for allocation failed or queue is NULL
+ */
+bool q_insert_sorted(struct list_head *head, char *s, bool descend);
+
 /**
  * q_remove_head() - Remove the element from head of queue
  * @head: header of queue
@@ -86,6 +225,7 @@ bool q_insert_tail(struct list_head *head, char *s);
  *
  * If sp is non-NULL and an element is removed, copy the removed string to *sp
  * (up to a maximum of bufsize-1 characters, plus a null terminator.)
+ * Only the string and its terminator are written, not the whole buffer.
  *
  * NOTE: "remove" is different from "delete"
  * The space used by the list element and the string should not be freed.
@@ -108,17 +248,64 @@ element_t *q_remove_head(struct list_head *head, char *sp, size_t bufsize);
  */
 element_t *q_remove_tail(struct list_head *head, char *sp, size_t bufsize);
 
+/**
+ * q_take_head() - Remove the element from head of queue without copying
+ * @head: header of queue
+ *
+ * Same as q_remove_head() with a NULL @sp. The string is handed over along
+ * with the element: e->value stays valid until q_release_element() is called
+ * on it, even if the queue is freed before.
+ *
+ * Return: the pointer to element, %NULL if queue is NULL or empty.
+ */
+element_t *q_take_head(struct list_head *head);
+
+/**
+ * q_take_tail() - Remove the element from tail of queue without copying
+ * @head: header of queue
+ *
+ * See q_take_head().
+ *
+ * Return: the pointer to element, %NULL if queue is NULL or empty.
+ */
+element_t *q_take_tail(struct list_head *head);
+
 /**
  * q_release_element() - Release the element
- * @e: element would be released
+ * @e: element returned by q_remove_head() or q_remove_tail()
+ *
+ * Elements live in slabs owned by their queue, so they cannot be handed to
+ * test_free() directly. The slab is freed along with its last element once
+ * it is no longer used for allocation, even if the queue is already gone.
  *
  * This function is intended for internal use only.
  */
-static inline void q_release_element(element_t *e)
-{
-    test_free(e->value);
-    test_free(e);
-}
+void q_release_element(element_t *e);
+
+/**
+ * q_index() - Keep a position index over the queue, or drop it
+ * @head: header of queue
+ * @on: whether or not the queue should be indexed
+ *
+ * The index is an indexable skip list which makes q_at() and q_delete_mid()
+ * take O(log n) time. It takes about 40 bytes per element, so small queues
+ * are better off without it. Inserting and removing at either end keep it
+ * up to date. Other operations leave it stale, and the next positional
+ * operation rebuilds it in O(n) time.
+ *
+ * Return: true for success, false if queue is NULL or the index could not be
+ * allocated.
+ */
+bool q_index(struct list_head *head, bool on);
+
+/**
+ * q_invalidate() - Tell the queue that its list was changed directly
+ * @head: header of queue
+ *
+ * Must be called after reordering the elements of the queue by any other
+ * means than the functions declared here, e.g. with list_sort().
+ */
+void q_invalidate(struct list_head *head);
 
 /**
  * q_size() - Get the size of the queue
@@ -128,6 +315,29 @@ static inline void q_release_element(element_t *e)
  */
 int q_size(struct list_head *head);
 
+/**
+ * q_memory() - Count the memory used by a queue
+ * @head: header of queue
+ *
+ * Includes whole slabs even if partly used, strings allocated separately and
+ * the index, if any. Takes O(n) time when there are such strings.
+ *
+ * Return: number of bytes, 0 if queue is NULL
+ */
+size_t q_memory(struct list_head *head);
+
+/**
+ * q_at() - Get the element at a position of the queue
+ * @head: header of queue
+ * @k: position, counted from 0 at the head
+ *
+ * Takes O(log n) time if the queue is indexed, see q_index(). Otherwise the
+ * list is walked from the nearer end.
+ *
+ * Return: the element, %NULL if queue is NULL or k is out of range.
+ */
+element_t *q_at(struct list_head *head, int k);
+
 /**
  * q_delete_mid() - Delete the middle node in queue
  * @head: header of queue
@@ -139,6 +349,8 @@ int q_size(struct list_head *head);
  * Reference:
  * https://leetcode.com/problems/delete-the-middle-node-of-a-linked-list/
  *
+ * Takes O(log n) time if the queue is indexed, see q_index().
+ *
  * Return: true for success, false if list is NULL or empty.
  */
 bool q_delete_mid(struct list_head *head);
@@ -155,6 +367,20 @@ bool q_delete_mid(struct list_head *head);
  */
 bool q_delete_dup(struct list_head *head);
 
+/**
+ * q_delete_dup_hash() - Delete all nodes that have duplicate string,
+ *                       leaving only distinct strings in their order
+ * @head: header of queue
+ *
+ * Unlike q_delete_dup(), the queue does not have to be sorted, and the
+ * remaining elements keep their order. The strings seen are kept in a hash
+ * set, which takes expected O(n) time.
+ *
+ * Return: true for success, false if list is NULL or the hash set could not
+ * be allocated, in which case the queue is left unchanged.
+ */
+bool q_delete_dup_hash(struct list_head *head);
+
 /**
  * q_swap() - Swap every two adjacent nodes
  * @head: header of queue
@@ -172,9 +398,67 @@ void q_swap(struct list_head *head);
  * This function should not allocate or free any list elements
  * (e.g., by calling q_insert_head, q_insert_tail, or q_remove_head).
  * It should rearrange the existing ones.
+ *
+ * If lazy_reverse is set, only the direction of the queue is flipped in O(1)
+ * time, see q_is_reversed().
  */
 void q_reverse(struct list_head *head);
 
+/**
+ * q_is_sorted() - Tell whether the queue is known to be sorted
+ * @head: header of queue
+ * @descend: whether to ask about descending order
+ *
+ * Inserting at either end compares the new element with its neighbour to
+ * keep track of the order. Removing elements keeps it, and q_sort(),
+ * q_merge(), q_ascend() and q_descend() establish it. q_swap(),
+ * q_reverseK(), q_shuffle() and q_invalidate() forget it. q_sort() returns
+ * at once if this is true.
+ *
+ * Return: true if the queue is in ascending/descending order from head to
+ * tail, false if it is not or that is unknown.
+ */
+bool q_is_sorted(struct list_head *head, bool descend);
+
+/**
+ * q_is_reversed() - Tell whether the queue is laid out backwards
+ * @head: header of queue
+ *
+ * The functions declared here all honour the direction of a queue. Code
+ * walking the list itself has to go from @head->prev to @head->next if this
+ * returns true, or call q_materialize() first.
+ *
+ * Return: true if the head of the queue is the last node of the list.
+ */
+bool q_is_reversed(struct list_head *head);
+
+/**
+ * q_is_ring() - Tell whether the elements of the queue are kept in an array
+ * @head: header of queue
+ *
+ * A ring queue holds pointers to its elements in a circular array which
+ * doubles when full. Inserting and removing at either end, q_size(), q_at()
+ * and q_reverse() take O(1) time, inserting being amortized over the
+ * growths. The list at @head stays empty meanwhile. Most other operations
+ * turn the queue into a list queue first, in O(n) time, and so does
+ * q_materialize(). Code walking the list itself has to call
+ * q_materialize() before if this returns true.
+ *
+ * Return: true if the queue is a ring queue.
+ */
+bool q_is_ring(struct list_head *head);
+
+/**
+ * q_materialize() - Lay out a lazily reversed queue from head to tail
+ * @head: header of queue
+ *
+ * Takes O(n) time if the queue is reversed or a ring queue, which becomes a
+ * list queue, and does nothing otherwise.
+ * q_swap(), q_reverseK(), q_ascend(), q_descend() and q_merge() call it
+ * themselves, while q_sort() and q_shuffle() just drop the direction.
+ */
+void q_materialize(struct list_head *head);
+
 /**
  * q_reverseK() - Given the head of a linked list, reverse the nodes of the list
  * k at a time.
@@ -196,7 +480,10 @@ void q_reverseK(struct list_head *head, int k);
  * @descend: whether or not to sort in descending order
  *
  * No effect if queue is NULL or empty. If there has only one element, do
- * nothing.
+ * nothing. If sort_adaptive is set, runs which are already in order are
+ * detected and merged, so a sorted queue is handled in linear time.
+ * Otherwise large queues are split into sort_threads segments, which are
+ * sorted and then merged pairwise by as many threads.
  */
 void q_sort(struct list_head *head, bool descend);
 
@@ -242,6 +529,8 @@ int q_descend(struct list_head *head);
  * in this function. There is no need to free the 'qcontext_t' and its member
  * 'q' since they will be released externally. However, q_merge() is responsible
  * for making the queues to be NULL-queue, except the first one.
+ * Neighbouring queues are merged pairwise in rounds, and the pairs of a round
+ * are merged by up to sort_threads threads.
  *
  * Reference:
  * https://leetcode.com/problems/merge-k-sorted-lists/
@@ -0,0 +1,118 @@
+/*
+ * MSD radix sort for queues of strings.
+ *
+ * A list holding strings that share their first @depth bytes is split into
+ * 256 buckets by the byte at @depth. Moving each node to the tail of its
+ * bucket keeps the sort stable. Strings that end at @depth fall into bucket
+ * 0 and are equal, every other bucket is sorted on the next byte, and the
+ * buckets are joined back in order. Small buckets are finished by insertion
+ * sort, and buckets still not split after RADIX_MAX_DEPTH bytes by merge
+ * sort, which bounds the recursion for long common prefixes.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "list_sort.h"
+#include "queue.h"
+#include "radixsort.h"
+
+/* Buckets with at most this many elements are sorted by insertion */
+#define RADIX_CUTOFF 16
+
+/* Maximum recursion depth, each level uses about 6 KiB of stack */
+#define RADIX_MAX_DEPTH 32
+
+/* The first 8 bytes are read from the key, saving a dereference of value */
+static inline unsigned char byte_at(const element_t *e, size_t depth)
+{
+    if (depth < 8)
+        return e->key >> (56 - 8 * depth);
+    return e->value[depth];
+}
+
+static inline int cmp_from(const struct list_head *a,
+                           const struct list_head *b,
+                           size_t depth,
+                           bool descend)
+{
+    const element_t *ea = list_entry(a, element_t, list);
+    const element_t *eb = list_entry(b, element_t, list);
+    int r = depth < 8 ? element_cmp(ea, eb)
+                      : strcmp(ea->value + depth, eb->value + depth);
+    return descend ? -r : r;
+}
+
+static int cmp_full(void *priv,
+                    const struct list_head *a,
+                    const struct list_head *b)
+{
+    return cmp_from(a, b, 0, *(bool *) priv);
+}
+
+static void insertion_sort(struct list_head *head, size_t depth, bool descend)
+{
+    struct list_head *node = head->next->next;
+    while (node != head) {
+        struct list_head *next = node->next, *pos = node->prev;
+        while (pos != head && cmp_from(pos, node, depth, descend) > 0)
+            pos = pos->prev;
+        if (pos != node->prev)
+            list_move(node, pos);
+        node = next;
+    }
+}
+
+static void msd_sort(struct list_head *head,
+                     size_t n,
+                     size_t depth,
+                     bool descend)
+{
+    if (n <= RADIX_CUTOFF) {
+        insertion_sort(head, depth, descend);
+        return;
+    }
+    if (depth >= RADIX_MAX_DEPTH) {
+        list_sort(&descend, head, cmp_full);
+        return;
+    }
+
+    /* Buckets are initialized on first use, as marked in @used */
+    struct list_head buckets[256];
+    size_t count[256];
+    uint64_t used[4] = {0};
+
+    struct list_head *node, *safe;
+    list_for_each_safe (node, safe, head) {
+        unsigned char c = byte_at(list_entry(node, element_t, list), depth);
+        if (!(used[c >> 6] & (1ULL << (c & 63)))) {
+            used[c >> 6] |= 1ULL << (c & 63);
+            INIT_LIST_HEAD(&buckets[c]);
+            count[c] = 0;
+        }
+        list_move_tail(node, &buckets[c]);
+        count[c]++;
+    }
+
+    for (int w = 0; w < 4; w++) {
+        int i = descend ? 3 - w : w;
+        uint64_t bits = used[i];
+        while (bits) {
+            int bit = descend ? 63 - __builtin_clzll(bits)
+                              : __builtin_ctzll(bits);
+            int c = i * 64 + bit;
+            bits &= ~(1ULL << bit);
+            if (c && count[c] > 1)
+                msd_sort(&buckets[c], count[c], depth + 1, descend);
+            list_splice_tail(&buckets[c], head);
+        }
+    }
+}
+
+void radix_sort(struct list_head *head, bool descend)
+{
+    if (!head || list_empty(head) || list_is_singular(head))
+        return;
+
+    msd_sort(head, q_size(head), 0, descend);
+}
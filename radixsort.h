@@ -0,0 +1,20 @@
+#ifndef LAB0_RADIXSORT_H
+#define LAB0_RADIXSORT_H
+
+#include <stdbool.h>
+
+#include "list.h"
+
+/**
+ * radix_sort() - Sort a queue by the bytes of its strings
+ * @head: header of queue
+ * @descend: whether or not to sort in descending order
+ *
+ * Most significant byte first radix sort. The elements are distributed into
+ * one bucket per byte value and each bucket is sorted on the next byte, so
+ * strcmp() is only called inside small buckets. Equal strings keep their
+ * relative order. No memory is allocated.
+ */
+void radix_sort(struct list_head *head, bool descend);
+
+#endif /* LAB0_RADIXSORT_H */
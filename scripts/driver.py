@@ -17,6 +17,7 @@ class Tracer:
     autograde = False
     useValgrind = False
     colored = False
+    backend = ""
 
     traceDict = {
         1: "trace-01-ops",
@@ -69,13 +70,15 @@ class Tracer:
                  verbLevel=0,
                  autograde=False,
                  useValgrind=False,
-                 colored=False):
+                 colored=False,
+                 backend=""):
         if qtest != "":
             self.qtest = qtest
         self.verbLevel = verbLevel
         self.autograde = autograde
         self.useValgrind = useValgrind
         self.colored = colored
+        self.backend = backend
 
     def printInColor(self, text, color):
         if self.colored == False:
@@ -113,6 +116,8 @@ class Tracer:
             self.command = ['valgrind', self.qtest]
         else:
             self.command = [self.qtest]
+        if self.backend != "":
+            self.command += ["-b", self.backend]
         for t in tidList:
             tname = self.traceDict[t]
             if self.verbLevel > 0:
@@ -146,11 +151,12 @@ class Tracer:
             sys.exit(1)
 
 def usage(name):
-    print("Usage: %s [-h] [-p PROG] [-t TID] [-v VLEVEL] [--valgrind] [-c]" % name)
+    print("Usage: %s [-h] [-p PROG] [-t TID] [-v VLEVEL] [-b BACKEND] [--valgrind] [-c]" % name)
     print("  -h        Print this message")
     print("  -p PROG   Program to test")
     print("  -t TID    Trace ID to test")
     print("  -v VLEVEL Set verbosity level (0-3)")
+    print("  -b BACKEND Run the queues of qtest on 'list' or 'unrolled'")
     print("  -c Enable colored text")
     sys.exit(0)
 
@@ -163,8 +169,9 @@ def run(name, args):
     autograde = False
     useValgrind = False
     colored = False
+    backend = ""
 
-    optlist, args = getopt.getopt(args, 'hp:t:v:A:c', ['valgrind'])
+    optlist, args = getopt.getopt(args, 'hp:t:v:A:cb:', ['valgrind'])
     for (opt, val) in optlist:
         if opt == '-h':
             usage(name)
@@ -181,6 +188,8 @@ def run(name, args):
             useValgrind = True
         elif opt == '-c':
             colored = True
+        elif opt == '-b':
+            backend = val
         else:
             print("Unrecognized option '%s'" % opt)
             usage(name)
@@ -190,7 +199,8 @@ def run(name, args):
                verbLevel=vlevel,
                autograde=autograde,
                useValgrind=useValgrind,
-               colored=colored)
+               colored=colored,
+               backend=backend)
     t.run(tid)
 
 
@@ -0,0 +1,141 @@
+/*
+ * Lock-free single-producer/single-consumer queue of strings.
+ *
+ * The strings are kept in a ring of slots whose size is a power of two. head
+ * and tail count the strings removed and inserted so far, and the slot of a
+ * string is its count masked. Only the consumer writes head and only the
+ * producer writes tail, each with a release store after it is done with the
+ * slot, which the other thread pairs with an acquire load before touching
+ * it. No other synchronization is needed.
+ *
+ * head and tail sit on cache lines of their own so that the two threads do
+ * not keep stealing each other's line. Each thread also caches the last
+ * value it read of the other's index, and only reads it again when the
+ * cached one says the queue is full or empty.
+ *
+ * This file does not include harness.h: the allocator of the test harness
+ * is not thread-safe, while long strings are allocated by the producer and
+ * freed by the consumer.
+ */
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "spsc.h"
+
+#define CACHE_LINE 64
+
+struct spsc_slot {
+    char *value;
+    char inline_value[SPSC_INLINE_SIZE];
+};
+
+struct spsc {
+    /* Producer side */
+    _Alignas(CACHE_LINE) atomic_size_t tail;
+    size_t head_cache;
+
+    /* Consumer side */
+    _Alignas(CACHE_LINE) atomic_size_t head;
+    size_t tail_cache;
+
+    /* Read-only once created */
+    _Alignas(CACHE_LINE) size_t mask;
+    struct spsc_slot *slots;
+};
+
+struct spsc *spsc_new(size_t capacity)
+{
+    size_t cap = 1;
+    while (cap < capacity) {
+        if (cap > SIZE_MAX / 2 / sizeof(struct spsc_slot))
+            return NULL;
+        cap <<= 1;
+    }
+
+    struct spsc *q = aligned_alloc(CACHE_LINE, sizeof(*q));
+    if (!q)
+        return NULL;
+    q->slots = malloc(cap * sizeof(*q->slots));
+    if (!q->slots) {
+        free(q);
+        return NULL;
+    }
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->head, 0);
+    q->head_cache = q->tail_cache = 0;
+    q->mask = cap - 1;
+    return q;
+}
+
+void spsc_free(struct spsc *q)
+{
+    if (!q)
+        return;
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    for (size_t i = atomic_load_explicit(&q->head, memory_order_relaxed);
+         i != tail; i++) {
+        struct spsc_slot *slot = &q->slots[i & q->mask];
+        if (slot->value != slot->inline_value)
+            free(slot->value);
+    }
+    free(q->slots);
+    free(q);
+}
+
+bool spsc_insert_tail(struct spsc *q, const char *s)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (tail - q->head_cache > q->mask) {
+        q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail - q->head_cache > q->mask)
+            return false;
+    }
+
+    struct spsc_slot *slot = &q->slots[tail & q->mask];
+    size_t len = strlen(s) + 1;
+    if (len <= SPSC_INLINE_SIZE) {
+        slot->value = slot->inline_value;
+    } else {
+        slot->value = malloc(len);
+        if (!slot->value)
+            return false;
+    }
+    memcpy(slot->value, s, len);
+
+    /* Publish the slot */
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool spsc_remove_head(struct spsc *q, char *sp, size_t bufsize)
+{
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (head == q->tail_cache) {
+        q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+        if (head == q->tail_cache)
+            return false;
+    }
+
+    struct spsc_slot *slot = &q->slots[head & q->mask];
+    if (sp && bufsize) {
+        size_t len = strnlen(slot->value, bufsize - 1);
+        memcpy(sp, slot->value, len);
+        sp[len] = '\0';
+    }
+    if (slot->value != slot->inline_value)
+        free(slot->value);
+
+    /* Hand the slot back to the producer */
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return true;
+}
+
+size_t spsc_size(struct spsc *q)
+{
+    /* head first, so that tail cannot be behind it */
+    size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+    return atomic_load_explicit(&q->tail, memory_order_acquire) - head;
+}
@@ -0,0 +1,71 @@
+#ifndef LAB0_SPSC_H
+#define LAB0_SPSC_H
+
+/* A bounded queue of strings handing them over from one producer thread to
+ * one consumer thread without locks. The producer inserts at the tail and
+ * the consumer removes from the head, with the semantics of q_insert_tail()
+ * and q_remove_head(). Any other use from more than one thread at a time is
+ * not supported.
+ *
+ * See the 'spsc' command of qtest for a benchmark.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Strings up to SPSC_INLINE_SIZE bytes, including the terminating null
+ * byte, are copied into the slot itself
+ */
+#define SPSC_INLINE_SIZE 56
+
+struct spsc;
+
+/**
+ * spsc_new() - Create an empty queue
+ * @capacity: number of strings the queue can hold, rounded up to a power of
+ *            two
+ *
+ * Return: NULL for allocation failed or capacity too large
+ */
+struct spsc *spsc_new(size_t capacity);
+
+/**
+ * spsc_free() - Free all storage used by queue, no effect if q is NULL
+ * @q: the queue, which no thread uses any more
+ */
+void spsc_free(struct spsc *q);
+
+/**
+ * spsc_insert_tail() - Insert a copy of s at the tail of the queue
+ * @q: the queue
+ * @s: string to insert
+ *
+ * Only the producer thread may call this. It does not wait for room.
+ *
+ * Return: true for success, false if the queue is full or allocation failed
+ */
+bool spsc_insert_tail(struct spsc *q, const char *s);
+
+/**
+ * spsc_remove_head() - Remove the string at the head of the queue
+ * @q: the queue
+ * @sp: buffer the string is copied to, or NULL
+ * @bufsize: size of @sp
+ *
+ * Only the consumer thread may call this. It does not wait for a string.
+ * At most bufsize - 1 characters are copied, plus a null terminator.
+ *
+ * Return: true for success, false if the queue is empty
+ */
+bool spsc_remove_head(struct spsc *q, char *sp, size_t bufsize);
+
+/**
+ * spsc_size() - Return the number of strings in the queue
+ * @q: the queue
+ *
+ * The result may be out of date by the time it is returned if the other
+ * thread is working on the queue.
+ */
+size_t spsc_size(struct spsc *q);
+
+#endif /* LAB0_SPSC_H */
@@ -0,0 +1,10 @@
+# Compare sorting random, sorted and reverse sorted queues with natural run
+# detection
+option adaptive 1
+new
+it RAND 500000
+time sort
+time sort
+reverse
+time sort
+time listsort
@@ -0,0 +1,3 @@
+# Compare the list queue with the unrolled list backend
+option malloc 0
+backends 200000
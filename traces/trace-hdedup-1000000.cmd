@@ -0,0 +1,13 @@
+# Remove duplicates from 1M random strings, with sort and dedup, then
+# in place with a hash set
+new
+it RAND 500000
+it RAND 500000
+time sort
+time dedup
+free
+new
+it RAND 500000
+it RAND 500000
+time hdedup
+free
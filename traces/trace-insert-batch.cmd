@@ -0,0 +1,10 @@
+# Insert many elements at once, which goes through the batch insert API
+option fail 0
+option malloc 0
+new
+time
+ih RAND 1000000
+time
+it dolphin 1000000
+time
+free
@@ -0,0 +1,17 @@
+# Sorted insertion: linear scan without index, skip-index search with it
+option fail 10
+new
+insort RAND 10000
+time
+free
+new
+index 1
+insort RAND 100000
+time
+option descend 1
+new
+index 1
+insort RAND 100000
+time
+free
+free
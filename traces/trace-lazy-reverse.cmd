@@ -0,0 +1,24 @@
+# Reverse a big queue in place, then by flipping its direction
+option fail 0
+option malloc 0
+new
+ih dolphin 1000000
+it gerbil 1000000
+time
+reverse
+reverse
+reverse
+reverse
+time
+option lazy-reverse 1
+reverse
+reverse
+reverse
+time
+rh gerbil
+rt dolphin
+ih gerbil
+it dolphin
+time
+sort
+free
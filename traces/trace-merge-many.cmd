@@ -0,0 +1,770 @@
+# Merge 256 sorted queues of 1000 elements each
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+new
+it RAND 1000
+sort
+time merge
@@ -0,0 +1,397 @@
+# Merge 32 sorted queues of 20000 elements with 2, 4, 8 and 16 threads
+option threads 2
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+time merge
+free
+option threads 4
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+time merge
+free
+option threads 8
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+time merge
+free
+option threads 16
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+new
+it RAND 20000
+sort
+time merge
+free
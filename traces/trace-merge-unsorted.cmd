@@ -0,0 +1,18 @@
+# Merge queues which are not sorted, then sort the result. merge reports
+# that its output is out of order, but sort must not take it for sorted.
+option error 10
+new
+it c
+it a
+new
+it b
+it d
+merge
+sort
+new
+it z
+it y
+new
+merge
+sort
+free
@@ -0,0 +1,2 @@
+# Pass numbers through the lock-free queue with 1 to 4 producers and consumers
+mpmc 100000 4
@@ -0,0 +1,3 @@
+new
+it RAND 1000000
+time radixsort
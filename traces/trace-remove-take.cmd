@@ -0,0 +1,19 @@
+# Remove with and without a string to check, from short and truncated strings,
+# and take without copying
+option length 5
+new
+it abcdefghijkl
+it ab
+ih xyz
+rt ab
+rh xyz
+rh
+it q
+ih abcdefghijkl
+tt
+th
+it r
+ih abcdefghijkl
+rt
+rh abcde
+free
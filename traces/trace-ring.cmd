@@ -0,0 +1,31 @@
+# Ring queues: operations at the ends, then ones which turn them into lists
+option ring 1
+new
+ih a
+ih b
+it c
+it d 20
+size
+rh b
+rt d
+reverse
+it e
+ih f
+rh f
+rt e
+size
+reverse
+at 0
+at 19
+sort
+insort b
+dm
+dedup
+option ring 0
+new
+it a
+free
+free
+# Time each insert as the array grows
+option malloc 0
+growth 200000
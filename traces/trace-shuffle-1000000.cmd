@@ -0,0 +1,10 @@
+# Shuffle 1M elements through an array, then block-wise without allocating
+new
+it RAND 1000000
+time shuffle
+free
+option noalloc-shuffle 1
+new
+it RAND 1000000
+time shuffle
+free
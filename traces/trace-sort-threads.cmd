@@ -0,0 +1,21 @@
+# Time sort on 1M elements with an increasing number of threads
+option threads 1
+new
+it RAND 1000000
+time sort
+free
+option threads 2
+new
+it RAND 1000000
+time sort
+free
+option threads 4
+new
+it RAND 1000000
+time sort
+free
+option threads 8
+new
+it RAND 1000000
+time sort
+free
@@ -0,0 +1,22 @@
+# Sorting a sorted queue again, and merging queues that do not overlap
+option fail 0
+option malloc 0
+new
+ih RAND 500000
+sort
+time
+sort
+sort
+sort
+sort
+it zzzzzzzzzz 100000
+sort
+time
+new
+ih aaaaaaaaaa 500000
+it aaaaaaaaab 500000
+merge
+time
+sort
+stats
+free
@@ -0,0 +1,3 @@
+# Hand strings between two threads through the lock-free queue
+spsc 200000
+spsc 20000 1
@@ -0,0 +1,12 @@
+# Merge sort by recursive tasks on the work-stealing pool
+wssort 300000 4
+# q_sort() and q_merge() run their threads on the pool too
+option threads 4
+new
+it RAND 100000
+sort
+new
+it RAND 50000
+sort
+merge
+free
@@ -27,8 +27,7 @@ node_t *list_make_node(struct list_head *list)
 {
     node_t *node = malloc(sizeof(node_t));
     node->list = list;
-    node->RBnode.value =
-        ((element_t *) list_entry(list, element_t, list))->value;
+    node->RBnode.value = list_entry(list, element_t, list);
     cmap_create_node(node);
     return node;
 }
@@ -341,7 +340,7 @@ node_t *cmap_next(node_t *node)
 
 void tree_sort(struct list_head *head)
 {
-    cmap_t map = cmap_new(sizeof(long), sizeof(NULL), cmap_cmp_str);
+    cmap_t map = cmap_new(sizeof(long), sizeof(NULL), cmap_cmp_element);
     struct list_head *list;
     list_for_each (list, head) {
         node_t *node = list_make_node(list);
@@ -6,10 +6,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "queue.h"
+
 struct rb_node {
     uintptr_t color;
     struct rb_node *left, *right;
-    char *value;
+    void *value;
 } __attribute__((aligned(sizeof(long))));
 
 typedef struct __node {
@@ -54,11 +56,10 @@ typedef enum { CMAP_RED = 0, CMAP_BLACK } color_t;
 
 enum { _CMP_LESS = -1, _CMP_EQUAL = 0, _CMP_GREATER = 1 };
 
-/* string comparison */
-static inline int cmap_cmp_str(void *arg0, void *arg1)
+/* element comparison, see element_cmp() in queue.h */
+static inline int cmap_cmp_element(void *arg0, void *arg1)
 {
-    char *a = (char *) arg0, *b = (char *) arg1;
-    int result = strcmp(a, b);
+    int result = element_cmp(arg0, arg1);
     return result < 0 ? _CMP_LESS : result > 0 ? _CMP_GREATER : _CMP_EQUAL;
 }
 
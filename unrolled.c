@@ -0,0 +1,559 @@
+/*
+ * Unrolled linked list backend for queues of strings.
+ *
+ * The strings of a chunk are kept in order in the used range [lo, hi) of its
+ * pointer array. Inserting at the tail fills the last chunk upwards and
+ * inserting at the head fills the first chunk downwards, a new chunk being
+ * started when there is no room left, so both take O(1) time. Chunks are
+ * never empty. Walking the queue reads consecutive pointers instead of
+ * chasing one list node per string.
+ *
+ * Each string is preceded by a pointer to the block it was carved from. The
+ * block counts its live strings and is freed once none is left, unless it is
+ * the one strings are currently allocated from.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "harness.h"
+#include "list.h"
+#include "unrolled.h"
+
+#define UQ_BLOCK 16384
+
+struct uq_chunk {
+    struct list_head link;
+    int lo, hi;
+    char *s[UQ_CHUNK];
+};
+
+struct uq_block {
+    struct list_head link;
+    size_t size; /* bytes of data */
+    size_t used;
+    size_t live;
+    char data[];
+};
+
+struct uqueue {
+    struct list_head chunks;
+    struct list_head blocks;
+    struct uq_block *cur; /* block strings are allocated from */
+    int size;
+};
+
+/* Slot i of chunk c, c being NULL past either end of the queue */
+struct uq_pos {
+    struct uq_chunk *c;
+    int i;
+};
+
+#define AT(p) ((p).c->s[(p).i])
+
+/* Each string is preceded by the block holding it */
+#define STRING_HEADER sizeof(struct uq_block *)
+#define string_block(s) (((struct uq_block **) (s))[-1])
+
+static char *string_new(struct uqueue *q, const char *s)
+{
+    size_t len = strlen(s) + 1;
+    size_t need = (STRING_HEADER + len + 7) & ~(size_t) 7;
+    struct uq_block *b = q->cur;
+
+    if (!b || b->used + need > b->size) {
+        size_t size = UQ_BLOCK - sizeof(*b);
+        if (need > size)
+            size = need;
+        b = malloc(sizeof(*b) + size);
+        if (!b)
+            return NULL;
+        b->size = size;
+        b->used = 0;
+        b->live = 0;
+        list_add(&b->link, &q->blocks);
+        if (q->cur && !q->cur->live) {
+            list_del(&q->cur->link);
+            free(q->cur);
+        }
+        q->cur = b;
+    }
+
+    char *p = b->data + b->used;
+    b->used += need;
+    b->live++;
+    *(struct uq_block **) p = b;
+    return memcpy(p + STRING_HEADER, s, len);
+}
+
+static void string_put(struct uqueue *q, char *s)
+{
+    struct uq_block *b = string_block(s);
+    if (!--b->live && b != q->cur) {
+        list_del(&b->link);
+        free(b);
+    }
+}
+
+static struct uq_chunk *chunk_new(struct uqueue *q, bool head)
+{
+    struct uq_chunk *c = malloc(sizeof(*c));
+    if (!c)
+        return NULL;
+    c->lo = c->hi = head ? UQ_CHUNK : 0;
+    if (head)
+        list_add(&c->link, &q->chunks);
+    else
+        list_add_tail(&c->link, &q->chunks);
+    return c;
+}
+
+static void chunk_del(struct uq_chunk *c)
+{
+    list_del(&c->link);
+    free(c);
+}
+
+static struct uq_pos pos_first(struct uqueue *q)
+{
+    struct uq_pos p = {NULL, 0};
+    if (!list_empty(&q->chunks)) {
+        p.c = list_first_entry(&q->chunks, struct uq_chunk, link);
+        p.i = p.c->lo;
+    }
+    return p;
+}
+
+static void pos_next(struct uqueue *q, struct uq_pos *p)
+{
+    if (++p->i < p->c->hi)
+        return;
+    if (p->c->link.next == &q->chunks) {
+        p->c = NULL;
+        return;
+    }
+    p->c = list_entry(p->c->link.next, struct uq_chunk, link);
+    p->i = p->c->lo;
+}
+
+static void pos_prev(struct uqueue *q, struct uq_pos *p)
+{
+    if (--p->i >= p->c->lo)
+        return;
+    if (p->c->link.prev == &q->chunks) {
+        p->c = NULL;
+        return;
+    }
+    p->c = list_entry(p->c->link.prev, struct uq_chunk, link);
+    p->i = p->c->hi - 1;
+}
+
+/* Drop the slots from w to the tail, whose strings have been moved or
+ * released already
+ */
+static void truncate_at(struct uqueue *q, struct uq_pos w)
+{
+    if (!w.c)
+        return;
+    while (w.c->link.next != &q->chunks)
+        chunk_del(list_entry(w.c->link.next, struct uq_chunk, link));
+    w.c->hi = w.i;
+    if (w.c->lo == w.c->hi)
+        chunk_del(w.c);
+}
+
+struct uqueue *uq_new(void)
+{
+    struct uqueue *q = malloc(sizeof(*q));
+    if (!q)
+        return NULL;
+    INIT_LIST_HEAD(&q->chunks);
+    INIT_LIST_HEAD(&q->blocks);
+    q->cur = NULL;
+    q->size = 0;
+    return q;
+}
+
+void uq_free(struct uqueue *q)
+{
+    if (!q)
+        return;
+    struct uq_chunk *c, *cs;
+    list_for_each_entry_safe (c, cs, &q->chunks, link)
+        free(c);
+    struct uq_block *b, *bs;
+    list_for_each_entry_safe (b, bs, &q->blocks, link)
+        free(b);
+    free(q);
+}
+
+static bool insert(struct uqueue *q, const char *s, bool head)
+{
+    if (!q)
+        return false;
+
+    struct uq_chunk *c = NULL;
+    if (!list_empty(&q->chunks)) {
+        c = head ? list_first_entry(&q->chunks, struct uq_chunk, link)
+                 : list_last_entry(&q->chunks, struct uq_chunk, link);
+        if (head ? !c->lo : c->hi == UQ_CHUNK)
+            c = NULL;
+    }
+    if (!c && !(c = chunk_new(q, head)))
+        return false;
+
+    char *copy = string_new(q, s);
+    if (!copy) {
+        if (c->lo == c->hi)
+            chunk_del(c);
+        return false;
+    }
+    if (head)
+        c->s[--c->lo] = copy;
+    else
+        c->s[c->hi++] = copy;
+    q->size++;
+    return true;
+}
+
+bool uq_insert_head(struct uqueue *q, const char *s)
+{
+    return insert(q, s, true);
+}
+
+bool uq_insert_tail(struct uqueue *q, const char *s)
+{
+    return insert(q, s, false);
+}
+
+static bool remove_end(struct uqueue *q, char *sp, size_t bufsize, bool head)
+{
+    if (!q || !q->size)
+        return false;
+
+    struct uq_chunk *c =
+        head ? list_first_entry(&q->chunks, struct uq_chunk, link)
+             : list_last_entry(&q->chunks, struct uq_chunk, link);
+    char *s = head ? c->s[c->lo++] : c->s[--c->hi];
+    if (c->lo == c->hi)
+        chunk_del(c);
+
+    if (sp && bufsize) {
+        size_t len = strnlen(s, bufsize - 1);
+        memcpy(sp, s, len);
+        sp[len] = '\0';
+    }
+    string_put(q, s);
+    q->size--;
+    return true;
+}
+
+bool uq_remove_head(struct uqueue *q, char *sp, size_t bufsize)
+{
+    return remove_end(q, sp, bufsize, true);
+}
+
+bool uq_remove_tail(struct uqueue *q, char *sp, size_t bufsize)
+{
+    return remove_end(q, sp, bufsize, false);
+}
+
+bool uq_delete_mid(struct uqueue *q)
+{
+    if (!q || !q->size)
+        return false;
+
+    int k = q->size / 2;
+    struct uq_chunk *c;
+    list_for_each_entry (c, &q->chunks, link) {
+        if (k < c->hi - c->lo)
+            break;
+        k -= c->hi - c->lo;
+    }
+
+    int i = c->lo + k;
+    string_put(q, c->s[i]);
+    memmove(&c->s[i], &c->s[i + 1], (c->hi - i - 1) * sizeof(c->s[0]));
+    if (c->lo == --c->hi)
+        chunk_del(c);
+    q->size--;
+    return true;
+}
+
+int uq_size(struct uqueue *q)
+{
+    return q ? q->size : -1;
+}
+
+void uq_reverse(struct uqueue *q)
+{
+    if (!q)
+        return;
+
+    struct list_head *node, *safe;
+    list_for_each_safe (node, safe, &q->chunks)
+        list_move(node, &q->chunks);
+
+    /* The used range of each chunk stays where it is */
+    struct uq_chunk *c;
+    list_for_each_entry (c, &q->chunks, link) {
+        for (int i = c->lo, j = c->hi - 1; i < j; i++, j--) {
+            char *t = c->s[i];
+            c->s[i] = c->s[j];
+            c->s[j] = t;
+        }
+    }
+}
+
+void uq_reverseK(struct uqueue *q, int k)
+{
+    if (!q || k <= 1)
+        return;
+
+    struct uq_pos a = pos_first(q);
+    for (int left = q->size; left >= k; left -= k) {
+        struct uq_pos b = a;
+        for (int i = 1; i < k; i++)
+            pos_next(q, &b);
+        struct uq_pos next = b;
+        pos_next(q, &next);
+
+        for (int i = 0; i < k / 2; i++) {
+            char *t = AT(a);
+            AT(a) = AT(b);
+            AT(b) = t;
+            pos_next(q, &a);
+            pos_prev(q, &b);
+        }
+        a = next;
+    }
+}
+
+void uq_swap(struct uqueue *q)
+{
+    if (!q)
+        return;
+
+    struct uq_pos a = pos_first(q);
+    while (a.c) {
+        struct uq_pos b = a;
+        pos_next(q, &b);
+        if (!b.c)
+            break;
+        char *t = AT(a);
+        AT(a) = AT(b);
+        AT(b) = t;
+        a = b;
+        pos_next(q, &a);
+    }
+}
+
+bool uq_sort(struct uqueue *q, bool descend)
+{
+    if (!q)
+        return false;
+    size_t n = q->size;
+    if (n < 2)
+        return true;
+
+    char **src = malloc(n * sizeof(*src));
+    char **dst = malloc(n * sizeof(*dst));
+    if (!src || !dst) {
+        free(src);
+        free(dst);
+        return false;
+    }
+
+    size_t i = 0;
+    for (struct uq_pos p = pos_first(q); p.c; pos_next(q, &p))
+        src[i++] = AT(p);
+
+    /* Bottom-up merge sort, taking from the left run on ties */
+    int sign = descend ? -1 : 1;
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = mid + width < n ? mid + width : n;
+            size_t l = lo, r = mid, o = lo;
+            while (l < mid && r < hi) {
+                if (sign * strcmp(src[l], src[r]) <= 0)
+                    dst[o++] = src[l++];
+                else
+                    dst[o++] = src[r++];
+            }
+            while (l < mid)
+                dst[o++] = src[l++];
+            while (r < hi)
+                dst[o++] = src[r++];
+        }
+        char **t = src;
+        src = dst;
+        dst = t;
+    }
+
+    i = 0;
+    for (struct uq_pos p = pos_first(q); p.c; pos_next(q, &p))
+        AT(p) = src[i++];
+    free(src);
+    free(dst);
+    return true;
+}
+
+bool uq_delete_dup(struct uqueue *q)
+{
+    if (!q)
+        return false;
+
+    struct uq_pos r = pos_first(q), w = r;
+    while (r.c) {
+        char *s = AT(r);
+        bool dup = false;
+        pos_next(q, &r);
+        while (r.c && !strcmp(AT(r), s)) {
+            string_put(q, AT(r));
+            q->size--;
+            dup = true;
+            pos_next(q, &r);
+        }
+        if (dup) {
+            string_put(q, s);
+            q->size--;
+        } else {
+            AT(w) = s;
+            pos_next(q, &w);
+        }
+    }
+    truncate_at(q, w);
+    return true;
+}
+
+int uq_ascend(struct uqueue *q)
+{
+    if (!q)
+        return 0;
+
+    struct uq_pos r = pos_first(q), w = r;
+    char *last = NULL;
+    for (; r.c; pos_next(q, &r)) {
+        char *s = AT(r);
+        if (!last || strcmp(last, s) < 0) {
+            AT(w) = last = s;
+            pos_next(q, &w);
+        } else {
+            string_put(q, s);
+            q->size--;
+        }
+    }
+    truncate_at(q, w);
+    return q->size;
+}
+
+int uq_descend(struct uqueue *q)
+{
+    if (!q)
+        return 0;
+
+    /* q_descend() keeps the strictly ascending strings from the tail */
+    uq_reverse(q);
+    uq_ascend(q);
+    uq_reverse(q);
+    return q->size;
+}
+
+/* Take the string at the head of q, moving its chunk to spare once empty */
+static char *take_head(struct uqueue *q, struct list_head *spare)
+{
+    struct uq_chunk *c = list_first_entry(&q->chunks, struct uq_chunk, link);
+    char *s = c->s[c->lo++];
+    if (c->lo == c->hi)
+        list_move(&c->link, spare);
+    return s;
+}
+
+int uq_merge(struct uqueue *a, struct uqueue *b, bool descend)
+{
+    if (!a || !b)
+        return a ? a->size : 0;
+
+    /* Chunks emptied by the merge are reused for its output. At most two
+     * input chunks are partly taken at any time, so the output never needs
+     * more than three chunks besides the emptied ones.
+     */
+    LIST_HEAD(spare);
+    for (int i = 0; i < 3; i++) {
+        struct uq_chunk *c = malloc(sizeof(*c));
+        if (!c) {
+            struct uq_chunk *cs;
+            list_for_each_entry_safe (c, cs, &spare, link)
+                free(c);
+            return -1;
+        }
+        list_add(&c->link, &spare);
+    }
+
+    LIST_HEAD(out);
+    struct uq_chunk *oc = NULL;
+    int sign = descend ? -1 : 1;
+    while (!list_empty(&a->chunks) && !list_empty(&b->chunks)) {
+        struct uq_chunk *ca =
+            list_first_entry(&a->chunks, struct uq_chunk, link);
+        struct uq_chunk *cb =
+            list_first_entry(&b->chunks, struct uq_chunk, link);
+        char *s = sign * strcmp(ca->s[ca->lo], cb->s[cb->lo]) <= 0
+                      ? take_head(a, &spare)
+                      : take_head(b, &spare);
+        if (!oc || oc->hi == UQ_CHUNK) {
+            oc = list_first_entry(&spare, struct uq_chunk, link);
+            oc->lo = oc->hi = 0;
+            list_move_tail(&oc->link, &out);
+        }
+        oc->s[oc->hi++] = s;
+    }
+    list_splice_tail_init(&a->chunks, &out);
+    list_splice_tail_init(&b->chunks, &out);
+    list_splice(&out, &a->chunks);
+
+    struct uq_chunk *c, *cs;
+    list_for_each_entry_safe (c, cs, &spare, link)
+        free(c);
+
+    /* Hand the strings of b over */
+    if (b->cur && !b->cur->live) {
+        list_del(&b->cur->link);
+        free(b->cur);
+    }
+    b->cur = NULL;
+    list_splice_init(&b->blocks, &a->blocks);
+    a->size += b->size;
+    b->size = 0;
+    return a->size;
+}
+
+bool uq_walk(struct uqueue *q,
+             bool (*fn)(const char *s, void *priv),
+             void *priv)
+{
+    if (!q)
+        return true;
+    for (struct uq_pos p = pos_first(q); p.c; pos_next(q, &p)) {
+        if (!fn(AT(p), priv))
+            return false;
+    }
+    return true;
+}
+
+size_t uq_memory(struct uqueue *q)
+{
+    if (!q)
+        return 0;
+
+    size_t bytes = sizeof(*q);
+    struct uq_chunk *c;
+    list_for_each_entry (c, &q->chunks, link)
+        bytes += sizeof(*c);
+    struct uq_block *b;
+    list_for_each_entry (b, &q->blocks, link)
+        bytes += sizeof(*b) + b->size;
+    return bytes;
+}
@@ -0,0 +1,182 @@
+#ifndef LAB0_UNROLLED_H
+#define LAB0_UNROLLED_H
+
+/* A queue of strings kept in an unrolled linked list: a doubly-linked list
+ * of chunks, each holding up to UQ_CHUNK string pointers in an array. The
+ * strings themselves are bump-allocated from blocks owned by the queue.
+ *
+ * The operations mirror the ones of queue.h. qtest runs its queue commands
+ * on this backend when started with '-b unrolled', and the 'backends'
+ * command compares both on the same workload.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Number of strings per chunk */
+#define UQ_CHUNK 64
+
+struct uqueue;
+
+/**
+ * uq_new() - Create an empty unrolled queue
+ *
+ * Return: NULL for allocation failed
+ */
+struct uqueue *uq_new(void);
+
+/**
+ * uq_free() - Free all storage used by queue, no effect if q is NULL
+ * @q: the queue
+ */
+void uq_free(struct uqueue *q);
+
+/**
+ * uq_insert_head() - Insert a copy of s at the head of the queue
+ * @q: the queue
+ * @s: string to insert
+ *
+ * Return: true for success, false for allocation failed or queue is NULL
+ */
+bool uq_insert_head(struct uqueue *q, const char *s);
+
+/**
+ * uq_insert_tail() - Insert a copy of s at the tail of the queue
+ * @q: the queue
+ * @s: string to insert
+ *
+ * Return: true for success, false for allocation failed or queue is NULL
+ */
+bool uq_insert_tail(struct uqueue *q, const char *s);
+
+/**
+ * uq_remove_head() - Remove the string at the head of the queue
+ * @q: the queue
+ * @sp: buffer the string is copied to, or NULL
+ * @bufsize: size of @sp
+ *
+ * At most bufsize - 1 characters are copied, plus a null terminator.
+ *
+ * Return: true for success, false if queue is NULL or empty
+ */
+bool uq_remove_head(struct uqueue *q, char *sp, size_t bufsize);
+
+/**
+ * uq_remove_tail() - Remove the string at the tail of the queue
+ * @q: the queue
+ * @sp: buffer the string is copied to, or NULL
+ * @bufsize: size of @sp
+ *
+ * Return: true for success, false if queue is NULL or empty
+ */
+bool uq_remove_tail(struct uqueue *q, char *sp, size_t bufsize);
+
+/**
+ * uq_delete_mid() - Delete the middle string, like q_delete_mid()
+ * @q: the queue
+ *
+ * The string at position size / 2, counted from 0 at the head, is deleted.
+ *
+ * Return: true for success, false if queue is NULL or empty
+ */
+bool uq_delete_mid(struct uqueue *q);
+
+/**
+ * uq_size() - Return the number of strings in the queue, -1 if q is NULL
+ * @q: the queue
+ */
+int uq_size(struct uqueue *q);
+
+/**
+ * uq_reverse() - Reverse the queue
+ * @q: the queue
+ *
+ * The order of the chunks is reversed, as well as the pointers inside each
+ * chunk.
+ */
+void uq_reverse(struct uqueue *q);
+
+/**
+ * uq_reverseK() - Reverse the strings of the queue k at a time
+ * @q: the queue
+ * @k: size of the groups, the last group is left as is if shorter
+ */
+void uq_reverseK(struct uqueue *q, int k);
+
+/**
+ * uq_swap() - Swap every two adjacent strings
+ * @q: the queue
+ */
+void uq_swap(struct uqueue *q);
+
+/**
+ * uq_sort() - Sort the queue in ascending/descending order
+ * @q: the queue
+ * @descend: whether or not to sort in descending order
+ *
+ * The string pointers are gathered into an array, sorted with a stable
+ * merge sort and written back in place.
+ *
+ * Return: true for success, false if the arrays could not be allocated, in
+ * which case the queue is left unchanged.
+ */
+bool uq_sort(struct uqueue *q, bool descend);
+
+/**
+ * uq_delete_dup() - Delete all strings that occur more than once
+ * @q: the sorted queue
+ *
+ * Return: true for success, false if queue is NULL
+ */
+bool uq_delete_dup(struct uqueue *q);
+
+/**
+ * uq_ascend() - Keep the strictly ascending strings, like q_ascend()
+ * @q: the queue
+ *
+ * Return: the number of strings left
+ */
+int uq_ascend(struct uqueue *q);
+
+/**
+ * uq_descend() - Keep the strictly descending strings, like q_descend()
+ * @q: the queue
+ *
+ * Return: the number of strings left
+ */
+int uq_descend(struct uqueue *q);
+
+/**
+ * uq_merge() - Merge two sorted queues
+ * @a: the queue which receives all the strings
+ * @b: the queue which is emptied
+ * @descend: whether the queues are sorted in descending order
+ *
+ * The strings of @b go after equal ones of @a, as with q_merge(). The
+ * storage of the strings of @b is handed over to @a. Up to three chunks are
+ * allocated for the output before anything is moved.
+ *
+ * Return: the size of @a, or -1 if these chunks could not be allocated, in
+ * which case both queues are left unchanged
+ */
+int uq_merge(struct uqueue *a, struct uqueue *b, bool descend);
+
+/**
+ * uq_walk() - Visit the strings of the queue from head to tail
+ * @q: the queue
+ * @fn: function called on each string, stops the walk by returning false
+ * @priv: passed to @fn
+ *
+ * Return: true if all the strings were visited
+ */
+bool uq_walk(struct uqueue *q,
+             bool (*fn)(const char *s, void *priv),
+             void *priv);
+
+/**
+ * uq_memory() - Return the number of bytes allocated for the queue
+ * @q: the queue
+ */
+size_t uq_memory(struct uqueue *q);
+
+#endif /* LAB0_UNROLLED_H */
@@ -0,0 +1,388 @@
+/*
+ * Work-stealing thread pool.
+ *
+ * The deques follow "Dynamic Circular Work-Stealing Deque" by David Chase
+ * and Yossi Lev, with the C11 memory orders of "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" by Nhat Minh Lê et al. top and
+ * bottom only ever grow, the slot of index i being i modulo the size of the
+ * array. The owner pushes and takes at bottom without atomic read-modify-
+ * write operations, except when taking the last task, which it races the
+ * thieves for with a compare-and-swap on top, as thieves do to steal.
+ *
+ * A full array is replaced by one twice as large. Thieves may still read
+ * the old one, which is kept until the deque is freed.
+ *
+ * A worker which finds nothing to steal sleeps on a condition variable
+ * until a task is spawned. Spawning only takes the lock when some worker
+ * sleeps: the spawner bumps a counter and then reads the number of sleepers,
+ * while a worker going to sleep counts itself and then checks the counter,
+ * so either the spawner sees the sleeper or the worker sees the new task.
+ *
+ * Memory comes from the C library allocator, since the one of the test
+ * harness is not thread-safe.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "workpool.h"
+
+#define CACHE_LINE 64
+#define DEQUE_MIN 64
+
+struct ws_array {
+    struct ws_array *older; /* array replaced by this one */
+    int64_t size;           /* a power of two */
+    _Atomic(struct wp_task *) buf[];
+};
+
+struct ws_deque {
+    _Alignas(CACHE_LINE) _Atomic int64_t top;
+    _Alignas(CACHE_LINE) _Atomic int64_t bottom;
+    _Atomic(struct ws_array *) array;
+};
+
+/**
+ * struct wp_worker - A thread of a pool
+ * @deque: tasks spawned by the thread
+ * @pool: the pool
+ * @thread: the thread, unused for the first worker, which is the one
+ *          calling workpool_run()
+ * @seed: state of the generator choosing whom to steal from
+ * @steals: number of tasks stolen by the thread
+ */
+struct wp_worker {
+    struct ws_deque deque;
+    struct workpool *pool;
+    pthread_t thread;
+    uint64_t seed;
+    unsigned long steals;
+};
+
+/**
+ * struct workpool - Threads and their deques
+ * @workers: the workers
+ * @threads: number of @workers
+ * @lock: protects @stop and the sleep of the workers
+ * @wake: signalled when a task is spawned or @stop is set
+ * @spawned: number of tasks spawned so far, wrapping around
+ * @sleepers: number of workers sleeping or about to
+ * @stop: the threads are to exit
+ */
+struct workpool {
+    struct wp_worker *workers;
+    int threads;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    atomic_uint spawned;
+    atomic_int sleepers;
+    bool stop;
+};
+
+/* Worker of the calling thread, while it runs tasks of a pool */
+static __thread struct wp_worker *self;
+
+static bool deque_init(struct ws_deque *d)
+{
+    struct ws_array *a = malloc(sizeof(*a) + DEQUE_MIN * sizeof(a->buf[0]));
+    if (!a)
+        return false;
+    a->older = NULL;
+    a->size = DEQUE_MIN;
+    atomic_init(&d->top, 0);
+    atomic_init(&d->bottom, 0);
+    atomic_init(&d->array, a);
+    return true;
+}
+
+static void deque_destroy(struct ws_deque *d)
+{
+    struct ws_array *a = atomic_load(&d->array);
+    while (a) {
+        struct ws_array *older = a->older;
+        free(a);
+        a = older;
+    }
+}
+
+/* Replace the array of d, holding the tasks from top to bottom, by one
+ * twice as large. Return NULL if out of memory.
+ */
+static struct ws_array *deque_grow(struct ws_deque *d,
+                                   struct ws_array *a,
+                                   int64_t top,
+                                   int64_t bottom)
+{
+    struct ws_array *b = malloc(sizeof(*b) + 2 * a->size * sizeof(b->buf[0]));
+    if (!b)
+        return NULL;
+    b->older = a;
+    b->size = 2 * a->size;
+    for (int64_t i = top; i < bottom; i++) {
+        struct wp_task *t = atomic_load_explicit(&a->buf[i & (a->size - 1)],
+                                                 memory_order_relaxed);
+        atomic_store_explicit(&b->buf[i & (b->size - 1)], t,
+                              memory_order_relaxed);
+    }
+    atomic_store_explicit(&d->array, b, memory_order_release);
+    return b;
+}
+
+/* Push a task at the bottom, by the owner only */
+static bool deque_push(struct ws_deque *d, struct wp_task *task)
+{
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    struct ws_array *a = atomic_load_explicit(&d->array, memory_order_relaxed);
+
+    if (b - t > a->size - 1) {
+        a = deque_grow(d, a, t, b);
+        if (!a)
+            return false;
+    }
+    atomic_store_explicit(&a->buf[b & (a->size - 1)], task,
+                          memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+    return true;
+}
+
+/* Take the task at the bottom, by the owner only. Return NULL if empty. */
+static struct wp_task *deque_take(struct ws_deque *d)
+{
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    struct ws_array *a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+    struct wp_task *task =
+        atomic_load_explicit(&a->buf[b & (a->size - 1)], memory_order_relaxed);
+    if (t == b) {
+        /* The last task, which a thief may be stealing too */
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                     memory_order_seq_cst,
+                                                     memory_order_relaxed))
+            task = NULL;
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+/* Steal the task at the top. Return NULL if empty or another thread took
+ * it first.
+ */
+static struct wp_task *deque_steal(struct ws_deque *d)
+{
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+
+    if (t >= b)
+        return NULL;
+    struct ws_array *a = atomic_load_explicit(&d->array, memory_order_acquire);
+    struct wp_task *task =
+        atomic_load_explicit(&a->buf[t & (a->size - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed))
+        return NULL;
+    return task;
+}
+
+void wp_task_init(struct wp_task *task, void (*fn)(struct wp_task *task))
+{
+    task->fn = fn;
+    task->parent = NULL;
+    atomic_init(&task->pending, 0);
+}
+
+static void run_task(struct wp_task *task)
+{
+    struct wp_task *parent = task->parent;
+
+    task->fn(task);
+    /* task may be gone as soon as its parent sees it done */
+    if (parent)
+        atomic_fetch_sub_explicit(&parent->pending, 1, memory_order_release);
+}
+
+/* Find a task in the deque of w, or else in the one of another worker */
+static struct wp_task *find_task(struct wp_worker *w)
+{
+    struct wp_task *task = deque_take(&w->deque);
+    if (task)
+        return task;
+
+    struct workpool *pool = w->pool;
+    for (int tries = 0; tries < pool->threads; tries++) {
+        w->seed ^= w->seed << 13;
+        w->seed ^= w->seed >> 7;
+        w->seed ^= w->seed << 17;
+        struct wp_worker *victim = &pool->workers[w->seed % pool->threads];
+        if (victim == w)
+            continue;
+        task = deque_steal(&victim->deque);
+        if (task) {
+            w->steals++;
+            return task;
+        }
+    }
+    return NULL;
+}
+
+void wp_spawn(struct wp_task *parent, struct wp_task *child)
+{
+    struct workpool *pool = self->pool;
+
+    child->parent = parent;
+    atomic_fetch_add_explicit(&parent->pending, 1, memory_order_relaxed);
+    if (!deque_push(&self->deque, child)) {
+        run_task(child);
+        return;
+    }
+
+    atomic_fetch_add(&pool->spawned, 1);
+    if (atomic_load(&pool->sleepers)) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+void wp_wait(struct wp_task *task)
+{
+    while (atomic_load_explicit(&task->pending, memory_order_acquire)) {
+        struct wp_task *other = find_task(self);
+        if (other)
+            run_task(other);
+        else
+            sched_yield();
+    }
+}
+
+static void *worker_main(void *arg)
+{
+    struct wp_worker *w = arg;
+    struct workpool *pool = w->pool;
+
+    /* No task is spawned before workpool_new() has set all workers up */
+    unsigned int seen = atomic_load(&pool->spawned);
+    self = w;
+    for (;;) {
+        /* Sleep until a task is spawned after the ones looked for */
+        pthread_mutex_lock(&pool->lock);
+        atomic_fetch_add(&pool->sleepers, 1);
+        while (!pool->stop && atomic_load(&pool->spawned) == seen)
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        atomic_fetch_sub(&pool->sleepers, 1);
+        bool stop = pool->stop;
+        pthread_mutex_unlock(&pool->lock);
+        if (stop)
+            break;
+
+        struct wp_task *task;
+        do {
+            seen = atomic_load(&pool->spawned);
+            task = find_task(w);
+            if (task)
+                run_task(task);
+        } while (task);
+    }
+    return NULL;
+}
+
+struct workpool *workpool_new(int threads)
+{
+    if (threads < 1)
+        return NULL;
+
+    struct workpool *pool = malloc(sizeof(*pool));
+    if (!pool)
+        return NULL;
+    pool->workers = aligned_alloc(CACHE_LINE, threads * sizeof(*pool->workers));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+    pool->threads = 0;
+    pool->stop = false;
+    atomic_init(&pool->spawned, 0);
+    atomic_init(&pool->sleepers, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    /* The threads inherit the signal mask, keep the alarm of qtest away */
+    sigset_t mask, old;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &mask, &old);
+    bool ok = true;
+    for (int i = 0; ok && i < threads; i++) {
+        struct wp_worker *w = &pool->workers[i];
+        w->pool = pool;
+        w->seed = (uintptr_t) w | 1;
+        w->steals = 0;
+        ok = deque_init(&w->deque);
+        if (ok && i)
+            ok = !pthread_create(&w->thread, NULL, worker_main, w);
+        if (ok)
+            pool->threads++;
+        else if (i)
+            deque_destroy(&w->deque);
+    }
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    if (!ok) {
+        workpool_free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void workpool_free(struct workpool *pool)
+{
+    if (!pool)
+        return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->threads; i++) {
+        if (i)
+            pthread_join(pool->workers[i].thread, NULL);
+        deque_destroy(&pool->workers[i].deque);
+    }
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+void workpool_run(struct workpool *pool, struct wp_task *task)
+{
+    if (self) {
+        run_task(task);
+        return;
+    }
+
+    /* The other workers wake up as tasks get spawned */
+    self = &pool->workers[0];
+    run_task(task);
+    self = NULL;
+}
+
+unsigned long workpool_steals(struct workpool *pool)
+{
+    unsigned long steals = 0;
+    for (int i = 0; i < pool->threads; i++)
+        steals += pool->workers[i].steals;
+    return steals;
+}
@@ -0,0 +1,92 @@
+#ifndef LAB0_WORKPOOL_H
+#define LAB0_WORKPOOL_H
+
+/* A pool of threads running fork-join tasks by work stealing. Each thread
+ * owns a Chase-Lev deque: the tasks it spawns are pushed at the bottom of
+ * its deque and it pops them back from there, most recent first, while idle
+ * threads steal the oldest ones from the top of the deques of others.
+ *
+ * q_sort() and q_merge() run their parallel work on such a pool, see
+ * sort_threads. The 'wssort' command of qtest runs a recursive merge sort
+ * on one.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+struct workpool;
+
+/**
+ * struct wp_task - A task, usually embedded in a structure holding its data
+ * @fn: work of the task
+ * @parent: task which spawned this one, NULL for the root task
+ * @pending: number of tasks spawned by this one which are not done yet
+ */
+struct wp_task {
+    void (*fn)(struct wp_task *task);
+    struct wp_task *parent;
+    atomic_int pending;
+};
+
+/**
+ * wp_task_init() - Prepare a task before it is spawned or run
+ * @task: the task
+ * @fn: work of the task
+ */
+void wp_task_init(struct wp_task *task, void (*fn)(struct wp_task *task));
+
+/**
+ * workpool_new() - Create a pool
+ * @threads: number of threads running tasks, including the one which calls
+ *           workpool_run()
+ *
+ * The threads of the pool sleep while there is no task to steal. They block
+ * all signals.
+ *
+ * Return: NULL for allocation failed or threads could not be created
+ */
+struct workpool *workpool_new(int threads);
+
+/**
+ * workpool_free() - Stop the threads of the pool and free it
+ * @pool: the pool, no effect if NULL
+ */
+void workpool_free(struct workpool *pool);
+
+/**
+ * workpool_run() - Run a task and all the ones it spawns
+ * @pool: the pool
+ * @task: the root task
+ *
+ * The calling thread takes part. Only one thread at a time may call this. If
+ * it is called from a task of the pool, @task is just run by the calling
+ * thread.
+ */
+void workpool_run(struct workpool *pool, struct wp_task *task);
+
+/**
+ * wp_spawn() - Let a task be run by any thread of the pool
+ * @parent: the running task
+ * @child: the new task, which must stay valid until wp_wait() on @parent
+ *         returns
+ *
+ * Must be called from a task of the pool. @child is run at once if there is
+ * no memory left to queue it.
+ */
+void wp_spawn(struct wp_task *parent, struct wp_task *child);
+
+/**
+ * wp_wait() - Wait for the tasks spawned by a task, running tasks meanwhile
+ * @task: the running task
+ *
+ * A task has to wait for its children before it returns.
+ */
+void wp_wait(struct wp_task *task);
+
+/**
+ * workpool_steals() - Return the number of tasks stolen so far in the pool
+ * @pool: the pool
+ */
+unsigned long workpool_steals(struct workpool *pool);
+
+#endif /* LAB0_WORKPOOL_H */